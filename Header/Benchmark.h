@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../Header/Renderer2D.h"
+#include "../Header/TextRenderer.h"
+
+#include <cstdint>
+#include <string>
+
+// Heap allocations made by the process so far (calls to the global operator new).
+// Counting replaces the global operator new, so it is compiled in only when
+// AC_BENCH_ALLOC_COUNT is defined; otherwise this always returns 0.
+#ifdef AC_BENCH_ALLOC_COUNT
+constexpr bool kCountsAllocations = true;
+#else
+constexpr bool kCountsAllocations = false;
+#endif
+std::uint64_t allocationCount();
+
+struct RenderBenchOptions
+{
+    int maxPrimitives = 100000;
+    double minSeconds = 0.25; // measuring time per case and scene size
+};
+
+// Render-throughput suite: synthetic scenes of 1, 10, ... maxPrimitives shapes,
+// text runs and status icons, each drawn repeatedly into the current target.
+// Prints one row per case and size with draws/sec (including GPU completion),
+// CPU submit ns per primitive and heap allocations per pass ("-" without
+// AC_BENCH_ALLOC_COUNT). Needs a current GL
+// context; the renderers must already match width x height.
+void runRenderBenchmarks(Renderer2D& renderer, TextRenderer& textRenderer, int width, int height, const RenderBenchOptions& options);
+
+struct SimBenchOptions
+{
+    std::string jsonPath;     // results written here when set
+    std::string baselinePath; // earlier JSON output to compare against when set
+    double maxRegressionPercent = 10.0;
+    double minSeconds = 0.2; // measuring time per repetition
+};
+
+// Simulation-core suite: unit-ticks/sec for updateVent, updateTemperature (built-in
+// and each controller), updateWater, handleTemperatureInput and the full tick, on
+// one unit and on batches. Needs no GL context. Returns nonzero when a case is
+// slower than the baseline by more than maxRegressionPercent.
+int runSimulationBenchmarks(const SimBenchOptions& options);
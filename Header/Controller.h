@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../Header/State.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Band around the target that counts as "reached" for the UI and controllers.
+constexpr float kTemperatureTolerance = 0.25f;
+
+// Pluggable thermostat: returns a normalized drive in [-1, 1] (negative cools,
+// positive heats) that scales AppState::tempDriftSpeed.
+class ThermostatController
+{
+public:
+    virtual ~ThermostatController() = default;
+
+    virtual float computeDrive(const AppState& state, float deltaTime) = 0;
+    virtual void reset() {}
+};
+
+// Original full-power on/off behavior; lands exactly on the target.
+class BangBangController : public ThermostatController
+{
+public:
+    float computeDrive(const AppState& state, float deltaTime) override;
+};
+
+struct PidGains
+{
+    float kp = 1.2f;
+    float ki = 0.15f;
+    float kd = 0.25f;
+    float integralLimit = 4.0f; // anti-windup clamp on the accumulated error
+};
+
+class PidController : public ThermostatController
+{
+public:
+    explicit PidController(const PidGains& gains = PidGains{});
+
+    float computeDrive(const AppState& state, float deltaTime) override;
+    void reset() override;
+
+private:
+    PidGains m_gains;
+    float m_integral = 0.0f;
+    float m_prevMeasurement = 0.0f;
+    bool m_hasPrev = false;
+};
+
+struct MpcConfig
+{
+    int horizonSteps = 16;
+    float stepSeconds = 0.25f; // prediction step
+    float driveDecay = 0.7f; // candidate drive shrinks by this factor each step
+    int candidateCount = 17; // drive levels spread evenly over [-1, 1], odd so 0 is included
+    float effortWeight = 0.02f; // penalty on |drive|^2
+    float slewWeight = 0.05f; // penalty on drive change versus last tick
+};
+
+// Model-predictive controller. Each candidate is a drive trajectory that starts
+// at one level and decays toward zero over the horizon; the plant is simulated
+// for all candidates at once and the cheapest first move is applied (receding horizon).
+class MpcController : public ThermostatController
+{
+public:
+    explicit MpcController(const MpcConfig& config = MpcConfig{});
+
+    float computeDrive(const AppState& state, float deltaTime) override;
+    void reset() override;
+
+    const MpcConfig& config() const { return m_config; }
+
+    // Solves many independent units in one call. previousDrives may be null.
+    void solveBatch(const float* currentTemps, const float* desiredTemps, const float* driftSpeeds,
+        const float* previousDrives, float* outDrives, std::size_t unitCount);
+
+private:
+    MpcConfig m_config;
+    std::vector<float> m_candidateDrives;
+    std::vector<float> m_candidateEffort;
+    std::vector<float> m_predicted;
+    std::vector<float> m_cost;
+    float m_lastDrive = 0.0f;
+};
+
+// Runs the MPC for a whole fleet with one solveBatch call per tick: the units
+// that are running are gathered into contiguous arrays, solved together and the
+// drives scattered back. Each unit's previous drive is kept for the slew penalty.
+class MpcBatch
+{
+public:
+    explicit MpcBatch(const MpcConfig& config = MpcConfig{});
+
+    // Same result as updateTemperature(unit, deltaTime, mpc) with one MpcController per unit.
+    void updateTemperatures(std::vector<AppState>& units, float deltaTime);
+
+private:
+    MpcController m_solver;
+    std::vector<float> m_lastDrives; // per unit
+    std::vector<std::size_t> m_active; // units solved this tick
+    std::vector<float> m_currentTemps;
+    std::vector<float> m_desiredTemps;
+    std::vector<float> m_driftSpeeds;
+    std::vector<float> m_previousDrives;
+    std::vector<float> m_drives;
+};
+
+// Builds a controller by name ("bangbang", "pid", "mpc"); null if unknown.
+std::unique_ptr<ThermostatController> createController(const std::string& name);
+
+// Drives currentTemp with the given controller instead of the built-in bang-bang step.
+void updateTemperature(AppState& state, float deltaTime, ThermostatController& controller);
@@ -3,4 +3,5 @@
 #include "../Header/Renderer2D.h"
 
 bool pointInRect(double px, double py, const RectShape& rect);
+bool pointInCircle(double px, double py, const CircleShape& circle);
 void drawHalfArrow(Renderer2D& renderer, const RectShape& button, bool isUp, const Color& arrowColor, const Color& bgColor);
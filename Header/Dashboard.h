@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../Header/Renderer2D.h"
+#include "../Header/State.h"
+#include "../Header/TextRenderer.h"
+
+#include <array>
+#include <vector>
+
+class RenderQueue;
+
+enum class DashboardControl
+{
+    None,
+    TemperatureUp,
+    TemperatureDown,
+    Power
+};
+
+// Starting states for a dashboard of count units, varied so they do not all move in lockstep.
+std::vector<AppState> makeDashboardUnits(int count);
+
+// Building view: units laid out on a grid in world space, drawn through a
+// pan/zoom transform. Only rows and columns that intersect the viewport are
+// visited, and the level of detail follows the on-screen unit size:
+//  - tiny units collapse to one quad colored by status,
+//  - mid-size units are flat rects with no text or icons,
+//  - close-up units get the full single-unit look.
+// The first two levels are batched per color, so a frame costs a fixed number
+// of draw calls however many units are visible.
+class Dashboard
+{
+public:
+    // aspect is the viewport width / height used to pick the column count.
+    Dashboard(int unitCount, float aspect);
+
+    int unitCount() const { return m_unitCount; }
+
+    void setViewportSize(float width, float height);
+    void fitAll();
+    void pan(float dx, float dy);
+    // Scales the view by factor, keeping the world point under (x, y) in place.
+    void zoomAt(float factor, float x, float y);
+
+    // Unit under the screen point (or -1) and the control hit inside it.
+    int pick(double x, double y, DashboardControl& control) const;
+
+    void setSelected(int unit) { m_selected = unit; }
+    int selected() const { return m_selected; }
+
+    // Returns the number of units drawn after culling. When the renderers record into
+    // queue, the digits go one layer above its current one: units never overlap, so
+    // every unit's text can be drawn in one run after all the shapes.
+    int draw(Renderer2D& renderer, TextRenderer& textRenderer, const std::vector<AppState>& units, RenderQueue* queue = nullptr) const;
+
+private:
+    // Batches in draw order; later slots paint over earlier ones.
+    enum Slot
+    {
+        SLOT_BODY,
+        SLOT_VENT,
+        SLOT_SCREEN_OFF,
+        SLOT_SCREEN_ON,
+        SLOT_STATUS_HEAT,
+        SLOT_STATUS_COOL,
+        SLOT_STATUS_OK,
+        SLOT_LAMP_OFF,
+        SLOT_LAMP_ON,
+        SLOT_ARROW,
+        SLOT_WATER,
+        SLOT_BOWL,
+        SLOT_QUAD_OFF,
+        SLOT_QUAD_LOCKED,
+        SLOT_QUAD_HEAT,
+        SLOT_QUAD_COOL,
+        SLOT_QUAD_OK,
+        SLOT_COUNT
+    };
+
+    void pushRect(Slot slot, float x, float y, float w, float h) const;
+    void batchQuad(const AppState& state, float x, float y) const;
+    void batchFlat(const AppState& state, float x, float y) const;
+    void drawFull(Renderer2D& renderer, TextRenderer& textRenderer, const AppState& state, float x, float y, RenderQueue* queue) const;
+
+    int m_unitCount = 0;
+    int m_columns = 1;
+    int m_rows = 1;
+    int m_selected = 0;
+
+    float m_viewWidth = 1.0f;
+    float m_viewHeight = 1.0f;
+    float m_zoom = 1.0f; // screen = world * zoom + pan
+    float m_panX = 0.0f;
+    float m_panY = 0.0f;
+    float m_minZoom = 0.01f;
+
+    mutable std::array<std::vector<float>, SLOT_COUNT> m_batches;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+enum class VsyncMode
+{
+    Off,
+    On,
+    Adaptive // late frames tear instead of waiting a whole refresh, when the driver supports it
+};
+
+bool parseVsyncMode(const std::string& text, VsyncMode& out);
+
+// Sets the swap interval for the current context; returns the interval applied.
+int applyVsync(VsyncMode mode);
+
+struct FrameTimeStats
+{
+    int frames = 0;
+    double meanMs = 0.0;
+    double stdDevMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+// Frame limiter: sleeps for the bulk of the remaining frame time, using a
+// running estimate of how late the OS wakes us, then spins for the rest.
+// Deadlines advance by whole periods so pacing does not drift.
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FramePacer(double targetFps = 75.0);
+
+    // 0 or less disables the limiter (e.g. when vsync paces the swap).
+    void setTargetFps(double fps);
+    double targetFps() const { return m_targetFps; }
+
+    // Call once at the top of every frame; records the interval since the last call.
+    void beginFrame();
+
+    // Blocks until the next frame deadline.
+    void waitForNextFrame();
+
+    // Same, but the coarse part goes through sleep(seconds), which may return early
+    // (e.g. glfwWaitEventsTimeout waking on input); it is called again until the budget is used up.
+    // On Windows the system timer runs at 1 ms resolution only for the length of the wait.
+    void waitForNextFrame(const std::function<void(double seconds)>& sleep);
+
+    // Time that can safely be spent sleeping before the spin phase has to start.
+    double sleepBudgetSeconds() const;
+    void spinUntilDeadline();
+
+    // Fills out stats for the last report interval once per interval, then resets them.
+    bool takeStats(FrameTimeStats& out, double intervalSeconds = 1.0);
+
+private:
+    void calibratedSleep(double seconds, const std::function<void(double seconds)>& sleep);
+
+    double m_targetFps = 0.0;
+    Clock::duration m_period{};
+    Clock::time_point m_deadline{};
+    Clock::time_point m_lastFrameStart{};
+    bool m_started = false;
+
+    double m_overshootEstimate = 0.001; // seconds the OS tends to oversleep
+
+    int m_frames = 0;
+    double m_sum = 0.0;
+    double m_sumSq = 0.0;
+    double m_min = 0.0;
+    double m_max = 0.0;
+    double m_windowSeconds = 0.0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct GlCallCounters
+{
+    std::uint64_t issued = 0; // reached the driver
+    std::uint64_t elided = 0; // skipped because the state already matched
+};
+
+// Shadow copy of the bits of GL state the renderers touch (program, vertex
+// array, array buffer, 2D textures per unit, uniform values per program).
+// Binds and uniform uploads that would not change anything never reach the
+// driver. Code that binds these directly must call invalidate() afterwards;
+// code that deletes a program or texture must call forgetProgram() or
+// forgetTexture(), since GL hands freed names out again.
+class GlState
+{
+public:
+    GlState();
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vertexArray);
+    void bindArrayBuffer(GLuint buffer);
+    void activeTexture(GLenum unit);
+    void bindTexture2D(GLuint texture); // on the active unit
+
+    // Uniforms of the program last passed to useProgram. Location -1 is ignored, as in GL.
+    void uniform1i(GLint location, GLint value);
+    void uniform2f(GLint location, float x, float y);
+    void uniform4f(GLint location, float x, float y, float z, float w);
+
+    void forgetProgram(GLuint program);
+    void forgetTexture(GLuint texture);
+    // Forgets every binding (not uniform values), e.g. after deleting bound objects.
+    void invalidate();
+
+    const GlCallCounters& counters() const { return m_counters; }
+
+private:
+    static constexpr GLuint kUnknown = ~0u;
+    static constexpr int kTextureUnits = 16;
+
+    struct UniformValue
+    {
+        bool known = false;
+        std::array<std::uint32_t, 4> bits{}; // raw float or int bits
+    };
+
+    bool setIfChanged(GLuint& current, GLuint value);
+    bool uniformChanged(GLint location, const std::array<std::uint32_t, 4>& bits);
+
+    GLuint m_program = kUnknown;
+    GLuint m_vertexArray = kUnknown;
+    GLuint m_arrayBuffer = kUnknown;
+    GLenum m_activeUnit = kUnknown;
+    std::array<GLuint, kTextureUnits> m_textures;
+
+    std::unordered_map<GLuint, std::vector<UniformValue>> m_uniforms; // by program, indexed by location
+    std::vector<UniformValue>* m_currentUniforms = nullptr;
+
+    GlCallCounters m_counters;
+};
+
+// The one tracker for the window's GL context, used from the render thread only.
+GlState& glState();
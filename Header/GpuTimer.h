@@ -0,0 +1,75 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+enum class GpuPass
+{
+    Clear,
+    Body, // body, vent, lamp and arrows; every unit's shapes in dashboard mode
+    ScreensText, // screens and digits; every unit's digits in dashboard mode
+    StatusIcon,
+    Bowl,
+    Graph,
+    Overlay, // stats text, profiler and nameplate
+    Count
+};
+
+const char* gpuPassName(GpuPass pass);
+
+struct GpuPassStats
+{
+    std::uint32_t samples = 0;
+    double meanMs = 0.0;
+    double maxMs = 0.0;
+};
+
+using GpuReport = std::array<GpuPassStats, static_cast<size_t>(GpuPass::Count)>;
+
+// GL_TIME_ELAPSED queries around each pass. Every frame uses its own set of
+// query objects from a small ring, and a set is only read back when the ring
+// comes round to it again, several frames later; results that are still not
+// available then are dropped rather than waited for, so timing never stalls
+// the pipeline. Time-elapsed queries cannot nest, so passes must not overlap.
+class GpuTimer
+{
+public:
+    GpuTimer();
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // Call before the first pass of a drawn frame.
+    void beginFrame();
+    // Starting a pass ends the previous one, so passes can simply be chained.
+    void begin(GpuPass pass);
+    void end();
+
+    // Once per interval, fills out the mean/max per pass since the last report.
+    bool takeReport(GpuReport& out, double intervalSeconds = 1.0);
+
+private:
+    static constexpr int kFramesInFlight = 4;
+    static constexpr int kPassCount = static_cast<int>(GpuPass::Count);
+
+    struct FrameQueries
+    {
+        std::array<GLuint, kPassCount> queries{};
+        std::array<bool, kPassCount> pending{};
+    };
+
+    void collect(FrameQueries& frame);
+
+    std::array<FrameQueries, kFramesInFlight> m_frames;
+    int m_current = 0;
+    int m_activePass = -1;
+
+    std::array<double, kPassCount> m_sumMs{};
+    std::array<double, kPassCount> m_maxMs{};
+    std::array<std::uint32_t, kPassCount> m_samples{};
+    std::chrono::steady_clock::time_point m_windowStart;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+enum class HeadlessBackend
+{
+    None,
+    Egl, // EGL surfaceless context, e.g. Mesa llvmpipe on a GPU-less host
+    OsMesa
+};
+
+bool parseHeadlessBackend(const std::string& text, HeadlessBackend& out);
+// Parses "WIDTHxHEIGHT".
+bool parseFrameSize(const std::string& text, int& width, int& height);
+
+// Before glfwInit: selects GLFW's null platform, which needs no display server.
+void configureHeadlessPlatform(HeadlessBackend backend);
+// After glfwInit, before glfwCreateWindow: hidden window whose context comes from the backend.
+void applyHeadlessWindowHints(HeadlessBackend backend);
+
+// Color framebuffer object used as the render target when there is no window
+// surface to draw into. Bind it once after creation; every pass draws into it.
+class OffscreenTarget
+{
+public:
+    OffscreenTarget(int width, int height);
+    ~OffscreenTarget();
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    bool isComplete() const { return m_complete; }
+    void bind() const;
+
+    // Reads the color buffer back and writes it as a binary PPM, top row first.
+    bool writePpm(const std::string& path) const;
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    GLuint m_framebuffer = 0;
+    GLuint m_colorBuffer = 0;
+    bool m_complete = false;
+};
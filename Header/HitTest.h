@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../Header/Renderer2D.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform-grid index over the interactive shapes on screen. Each control is
+// filed under every grid cell its bounds touch, and each cell keeps its list
+// sorted top-most first, so a click looks up one cell and tests a handful of
+// shapes however many controls are laid out. Ids are chosen by the caller.
+class HitTestGrid
+{
+public:
+    explicit HitTestGrid(float cellSize = 64.0f);
+
+    // Adds the control or moves it; only the cells it enters or leaves are touched.
+    // Higher z wins when shapes overlap, then the higher id.
+    void setRect(int id, const RectShape& rect, int z = 0);
+    void setCircle(int id, const CircleShape& circle, int z = 0);
+    void remove(int id);
+    void clear();
+
+    // Top-most control containing the point, or -1.
+    int hitTest(double x, double y) const;
+
+private:
+    enum class Kind { Rect, Circle };
+
+    struct Control
+    {
+        bool active = false;
+        Kind kind = Kind::Rect;
+        RectShape rect{};
+        CircleShape circle{};
+        int z = 0;
+        int minCellX = 0, minCellY = 0, maxCellX = 0, maxCellY = 0;
+    };
+
+    void place(int id, const Control& updated, float minX, float minY, float maxX, float maxY);
+    void unlink(int id, const Control& control);
+    void link(int id, const Control& control);
+    bool ranksAbove(int a, int b) const;
+    bool contains(const Control& control, double x, double y) const;
+    int cellCoord(double v) const;
+    static std::uint64_t cellKey(int cx, int cy);
+
+    float m_cellSize;
+    std::vector<Control> m_controls; // indexed by id
+    std::unordered_map<std::uint64_t, std::vector<int>> m_cells;
+};
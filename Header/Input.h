@@ -0,0 +1,45 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <vector>
+
+enum class InputEventType
+{
+    Key,
+    MouseButton,
+    Scroll,
+    CursorMove
+};
+
+// One GLFW input callback, stamped when it fired.
+struct InputEvent
+{
+    InputEventType type = InputEventType::Key;
+    int code = 0; // GLFW_KEY_* or GLFW_MOUSE_BUTTON_*
+    int action = 0; // GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+    double x = 0.0; // cursor position at the time of the event
+    double y = 0.0;
+    double scroll = 0.0; // vertical wheel steps, Scroll only
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+// Collects GLFW key, mouse and scroll callbacks into an ordered queue. Unlike
+// polling glfwGetKey once per frame, a press and release inside one frame are
+// both seen, and every event keeps the time it actually happened. The GLFW
+// callbacks that feed it are installed in main next to the resize callback.
+class InputSystem
+{
+public:
+    // Moves every queued event into out (cleared first), oldest first.
+    void drain(std::vector<InputEvent>& out);
+
+    void onKey(int key, int action);
+    void onMouseButton(GLFWwindow* window, int button, int action);
+    void onScroll(GLFWwindow* window, double yOffset);
+    void onCursorMove(double x, double y);
+
+private:
+    std::vector<InputEvent> m_events;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../Header/State.h"
+
+// Tracks whether anything visible changed since the last presented frame, so
+// the power-save loop can skip clear/draw/swap entirely while the scene is static.
+class RenderDamage
+{
+public:
+    void markDirty() { m_dirty = true; }
+    bool isDirty() const { return m_dirty; }
+
+    // Compares the parts of the state that reach the screen against the last presented frame.
+    void checkState(const AppState& state);
+    void markPresented() { m_dirty = false; }
+
+private:
+    struct VisualKey
+    {
+        bool isOn = false;
+        bool lockedByFullBowl = false;
+        float ventOpenness = 0.0f;
+        float waterLevel = 0.0f;
+        int desiredShown = 0; // values as rounded on the screens
+        int currentShown = 0;
+        int statusIcon = 0; // -1 cooling, 0 reached, 1 heating
+    };
+
+    static VisualKey makeKey(const AppState& state);
+
+    VisualKey m_last;
+    bool m_dirty = true;
+};
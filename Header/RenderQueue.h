@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../Header/Renderer2D.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class TextRenderer;
+
+enum class RenderProgramId : std::uint8_t
+{
+    Basic, // Renderer2D shapes
+    Text
+};
+
+// Deferred draws for one frame. While a queue is attached to the renderers
+// (Renderer2D::setQueue, TextRenderer::setQueue) their draw calls are recorded
+// instead of issued; flush() sorts the records by a 64-bit key with a radix sort
+// and replays them, so each program is bound once per layer rather than every
+// time the frame code alternates between shapes and text.
+//
+// Key, high to low: layer (8 bits) | program (8) | sequence (32).
+// Layers are the caller's painter order: anything that has to cover a draw made
+// with another program goes in a later layer. Inside a layer, draws with the same
+// program keep their recorded order, so overlapping shapes of one kind still
+// blend exactly as before. Textures are not part of the key: the only textured
+// draw is text, which binds one texture per glyph.
+class RenderQueue
+{
+public:
+    void setLayer(std::uint8_t layer) { m_layer = layer; }
+    std::uint8_t layer() const { return m_layer; }
+    size_t size() const { return m_keys.size(); }
+
+    // Recording, called by attached renderers with the same arguments as their draw calls.
+    void rect(float x, float y, float w, float h, const Color& color);
+    void circle(float cx, float cy, float radius, const Color& color, int segments);
+    void triangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color);
+    void lineStrips(const std::vector<float>& points, const std::vector<LineStrip>& strips);
+    void rects(const std::vector<float>& rects, const Color& color);
+    void text(const std::string& text, float x, float y, float scale, const Color& color);
+
+    // Called before the first draw of each layer that has any, e.g. to start a GPU timer pass.
+    using LayerCallback = std::function<void(std::uint8_t layer)>;
+
+    // Detaches the queue from both renderers, draws everything in key order and
+    // clears the queue (keeping its storage for the next frame). Layer resets to 0.
+    void flush(Renderer2D& renderer, TextRenderer& textRenderer, const LayerCallback& onLayer = LayerCallback());
+
+private:
+    enum class Kind : std::uint8_t { Rect, Circle, Triangle, LineStrips, Rects, Text };
+
+    struct Command
+    {
+        Kind kind = Kind::Rect;
+        Color color{};
+        float v[6] = {}; // geometry, meaning depends on kind
+        int segments = 0;
+        std::uint32_t first = 0; // into m_floats, or m_texts for text
+        std::uint32_t count = 0;
+        std::uint32_t stripFirst = 0; // into m_strips
+        std::uint32_t stripCount = 0;
+    };
+
+    Command& push(Kind kind, RenderProgramId program);
+
+    std::uint8_t m_layer = 0;
+    std::vector<Command> m_commands; // in recording order; the key's low bits index it
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint64_t> m_sortScratch;
+    std::vector<float> m_floats;
+    std::vector<LineStrip> m_strips;
+    std::vector<std::string> m_texts; // slots reused across frames, so short strings do not allocate
+    size_t m_textCount = 0;
+
+    // Reused replay buffers for the vector-taking draw calls.
+    std::vector<float> m_replayFloats;
+    std::vector<LineStrip> m_replayStrips;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "../Header/ShaderManager.h"
+
 #include <GL/glew.h>
+#include <vector>
 
 struct Color
 {
@@ -19,6 +22,20 @@ struct CircleShape
     Color color;
 };
 
+// Range of vertices inside a shared point buffer drawn as one GL_LINE_STRIP.
+struct LineStrip
+{
+    int first;
+    int count;
+    Color color;
+};
+
+// Segment count of the precomputed circle LOD used for a radius in pixels: the
+// smallest level whose chord error stays under a quarter pixel, from 8 up to 128.
+int circleSegmentsFor(float radiusPx);
+
+class RenderQueue;
+
 class Renderer2D
 {
 public:
@@ -26,16 +43,31 @@ public:
     ~Renderer2D();
 
     void drawRect(float x, float y, float w, float h, const Color& color) const;
-    void drawCircle(float cx, float cy, float radius, const Color& color, int segments = 48) const;
+    // segments <= 0 picks the count from the on-screen radius (see circleSegmentsFor).
+    void drawCircle(float cx, float cy, float radius, const Color& color, int segments = 0) const;
     void drawFrame(const RectShape& rect, float thickness) const;
     void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color) const;
+    // Uploads all points (pixel x,y pairs) once and draws every strip from that buffer.
+    void drawLineStrips(const std::vector<float>& points, const std::vector<LineStrip>& strips) const;
+    // Draws many same-colored rects (pixel x,y,w,h quadruples) with one upload and one draw call.
+    void drawRects(const std::vector<float>& rects, const Color& color) const;
     void setWindowSize(float width, float height);
+    // While a queue is set the draw calls above record into it instead of drawing;
+    // RenderQueue::flush detaches it and replays the commands in sorted order.
+    void setQueue(RenderQueue* queue) { m_queue = queue; }
 
 private:
+    // Binds the program behind m_shader; uniform locations are refreshed when it is first
+    // used and whenever a hot reload replaces it.
+    void useProgram() const;
+
     float m_windowWidth;
     float m_windowHeight;
-    GLuint m_program = 0;
+    RenderQueue* m_queue = nullptr;
+    ShaderManager::Handle m_shader = ShaderManager::kInvalidHandle;
+    mutable unsigned int m_shaderVersion = ~0u; // version the uniform locations belong to
     GLuint m_vao = 0;
     GLuint m_vbo = 0;
-    GLint m_uColorLocation = -1;
+    mutable GLint m_uColorLocation = -1;
+    mutable std::vector<float> m_scratch;
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../Header/HitTest.h"
+#include "../Header/Renderer2D.h"
+
+#include <array>
+
+// One AC unit in scene units, with the body's top-left corner at the origin. The
+// single-unit view and every unit on the dashboard are built from these.
+constexpr float kUnitBodyW = 480.0f;
+constexpr float kUnitBodyH = 200.0f;
+constexpr float kUnitVentX = 24.0f;
+constexpr float kUnitVentY = kUnitBodyH - 64.0f;
+constexpr float kUnitVentW = kUnitBodyW - 48.0f;
+constexpr float kUnitVentClosedH = 4.0f;
+constexpr float kUnitVentOpenH = 18.0f;
+constexpr float kUnitLampX = kUnitBodyW - 44.0f;
+constexpr float kUnitLampY = kUnitBodyH - 26.0f;
+constexpr float kUnitLampR = 14.0f;
+constexpr float kUnitScreenX = 70.0f;
+constexpr float kUnitScreenY = 52.0f;
+constexpr float kUnitScreenW = 94.0f;
+constexpr float kUnitScreenH = 54.0f;
+constexpr float kUnitScreenStep = kUnitScreenW + 22.0f;
+constexpr float kUnitArrowW = 40.0f;
+constexpr float kUnitArrowX = kUnitScreenX - kUnitArrowW - 12.0f;
+constexpr float kUnitBowlW = 260.0f;
+constexpr float kUnitBowlH = 140.0f;
+constexpr float kUnitBowlX = (kUnitBodyW - kUnitBowlW) * 0.5f;
+constexpr float kUnitBowlY = kUnitBodyH + 120.0f;
+constexpr float kUnitBowlThickness = 10.0f;
+
+constexpr Color kUnitBodyColor{ 0.90f, 0.93f, 0.95f, 1.0f };
+constexpr Color kUnitVentColor{ 0.32f, 0.36f, 0.45f, 1.0f };
+constexpr Color kUnitLampOffColor{ 0.22f, 0.18f, 0.20f, 1.0f };
+constexpr Color kUnitLampOnColor{ 0.93f, 0.22f, 0.20f, 1.0f };
+constexpr Color kUnitScreenOffColor{ 0.08f, 0.10f, 0.12f, 1.0f };
+constexpr Color kUnitScreenOnColor{ 0.18f, 0.68f, 0.72f, 1.0f };
+constexpr Color kUnitBowlColor{ 0.78f, 0.82f, 0.88f, 1.0f };
+constexpr Color kUnitDigitColor{ 0.96f, 0.98f, 1.0f, 1.0f };
+constexpr Color kUnitArrowBg{ 0.15f, 0.18f, 0.22f, 1.0f };
+constexpr Color kUnitArrowColor{ 0.90f, 0.96f, 1.0f, 1.0f };
+constexpr Color kUnitWaterColor{ 0.50f, 0.78f, 0.94f, 0.9f };
+
+// Ids of the clickable controls in the scene's hit-test grid.
+enum ControlId
+{
+    CONTROL_TEMP_UP,
+    CONTROL_TEMP_DOWN,
+    CONTROL_POWER
+};
+
+// Shapes of the single-unit scene, in scene space or already placed on screen.
+struct SceneShapes
+{
+    RectShape body{};
+    RectShape vent{};
+    CircleShape lamp{};
+    std::array<RectShape, 3> screens{};
+    RectShape tempArrow{};
+    RectShape bowl{};
+    RectShape graph{};
+    float bowlThickness = 0.0f;
+};
+
+// The unit's body, vent, lamp, screens, arrow button and bowl from the constants
+// above, in their "off" colors. The graph panel is left for the caller.
+SceneShapes makeUnitShapes();
+
+// Centers the scene in the framebuffer. Everything derived from the window size
+// (offsets, placed shapes, arrow halves, bowl interior, hit-test grid) is
+// computed in resize(), which runs from the framebuffer-size callback, so
+// frames without a resize only read cached values.
+class SceneLayout
+{
+public:
+    explicit SceneLayout(const SceneShapes& scene);
+
+    void resize(int framebufferWidth, int framebufferHeight);
+
+    const SceneShapes& placed() const { return m_placed; }
+    const RectShape& arrowUp() const { return m_arrowUp; }
+    const RectShape& arrowDown() const { return m_arrowDown; }
+    const RectShape& bowlInner() const { return m_bowlInner; }
+
+    // Top-most ControlId under the point, or -1.
+    int hitTest(double x, double y) const { return m_hitGrid.hitTest(x, y); }
+
+private:
+    SceneShapes m_scene;
+    float m_minX = 0.0f;
+    float m_minY = 0.0f;
+    float m_width = 0.0f;
+    float m_height = 0.0f;
+
+    SceneShapes m_placed;
+    RectShape m_arrowUp{};
+    RectShape m_arrowDown{};
+    RectShape m_bowlInner{};
+    HitTestGrid m_hitGrid;
+};
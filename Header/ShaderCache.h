@@ -0,0 +1,19 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+// On-disk cache of linked shader programs (glGetProgramBinary / glProgramBinary).
+// Entries are keyed by a hash of both shader sources plus the GL vendor,
+// renderer and version strings, so an edited shader or a driver update simply
+// misses. Everything fails soft: a missing, stale or rejected binary returns 0
+// and the caller compiles from source as before.
+void setShaderCacheDirectory(const std::string& directory); // empty disables the cache
+
+// A linked program from the cache, or 0 on a miss.
+GLuint loadCachedProgram(const std::string& vertexSource, const std::string& fragmentSource);
+// Call before glLinkProgram so the driver keeps a retrievable binary.
+void prepareProgramForCache(GLuint program);
+// Saves a successfully linked program under its sources' key.
+void storeCachedProgram(GLuint program, const std::string& vertexSource, const std::string& fragmentSource);
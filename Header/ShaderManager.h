@@ -0,0 +1,82 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+// Builds every shader program up front and checks the results only when a
+// program is first used. Compiles and links are issued back to back with no
+// status query in between, so a driver that compiles on its own threads
+// (GL_KHR_parallel_shader_compile, or Mesa's and NVIDIA's threaded compilers)
+// works on all programs at once while start-up continues with font loading and
+// scene setup. Programs come from the binary shader cache when possible.
+//
+// Users keep the handle, not the GL program: a hot reload swaps the program
+// behind the handle and bumps its version, which tells them to look their
+// uniform locations up again.
+class ShaderManager
+{
+public:
+    using Handle = int;
+    static constexpr Handle kInvalidHandle = -1;
+
+    // With the GL context current: lets the driver use as many compile threads as it likes.
+    void init();
+
+    // Starts building the program; the same pair of paths always returns the same handle.
+    Handle submit(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // True once the program can be used without waiting. Never blocks.
+    bool isReady(Handle handle) const;
+
+    // The program for the handle, or 0 for an invalid one. The first call waits
+    // for the driver, reports compile and link errors and saves the binary to
+    // the shader cache.
+    GLuint program(Handle handle);
+    // Changes each time reload swaps in a new program.
+    unsigned int version(Handle handle) const;
+
+    // Starts rebuilding every program that uses the shader file with this name.
+    // The compile is issued on the calling (render) thread, so it only runs in the
+    // background when the driver has KHR/ARB_parallel_shader_compile or its own
+    // compile threads; otherwise the frame that calls update() waits for it.
+    // Nothing changes until update() sees the result.
+    void reload(const std::string& fileName);
+    // Once per frame: swaps in rebuilt programs that linked, and keeps the last
+    // good program (reporting the error) for those that did not. Waits only when
+    // the driver cannot report completion. Returns true if a program changed.
+    bool update();
+
+    // Deletes every program the manager owns; all handles become invalid.
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::string vertexSource; // kept until resolved, as the cache key
+        std::string fragmentSource;
+        GLuint program = 0;
+        GLuint vertexShader = 0;
+        GLuint fragmentShader = 0;
+        bool resolved = false;
+        unsigned int version = 0;
+
+        // Rebuild in flight from reload().
+        GLuint pendingProgram = 0;
+        GLuint pendingVertexShader = 0;
+        GLuint pendingFragmentShader = 0;
+        bool pendingSeenOnce = false;
+    };
+
+    void resolve(Entry& entry);
+    void discardPending(Entry& entry);
+
+    std::vector<Entry> m_entries;
+    bool m_parallel = false;
+};
+
+// Process-wide manager shared by the renderers and main().
+ShaderManager& shaderManager();
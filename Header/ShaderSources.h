@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+// Shader sources are compiled into the executable: Header/EmbeddedShaders.h is
+// generated from Shaders/ by Tools/EmbedShaders.ps1 before every build, so
+// start-up reads no files and works from any working directory. For shader
+// work an override directory can be set; files found there win over the
+// embedded copies without a rebuild.
+void setShaderOverrideDirectory(const std::string& directory); // empty disables
+const std::string& shaderOverrideDirectory();
+
+// Source for a path such as "Shaders/basic.vert", looked up by file name: the
+// override directory first, then the embedded table, then the path on disk.
+std::string loadShaderSource(const std::string& path);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Watches a shader directory on a background thread (inotify on Linux,
+// ReadDirectoryChangesW on Windows) and collects the names of files that were
+// written or renamed into it. The render thread picks them up once per frame
+// with takeChanges and hands them to ShaderManager::reload.
+class ShaderWatcher
+{
+public:
+    explicit ShaderWatcher(const std::string& directory);
+    ~ShaderWatcher();
+
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    bool isWatching() const { return m_watching; }
+
+    // Moves the changed file names (without directory, no duplicates) into out.
+    // Returns false when nothing changed since the last call.
+    bool takeChanges(std::vector<std::string>& out);
+
+private:
+    void run();
+    void notify(const std::string& fileName);
+
+    std::string m_directory;
+    std::atomic<bool> m_running{ false };
+    bool m_watching = false;
+    std::thread m_thread;
+
+    std::mutex m_mutex;
+    std::vector<std::string> m_changes;
+
+#ifdef _WIN32
+    void* m_directoryHandle = nullptr;
+#else
+    int m_inotify = -1;
+#endif
+};
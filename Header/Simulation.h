@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../Header/Controller.h"
+#include "../Header/Profiler.h"
+#include "../Header/SpscQueue.h"
+#include "../Header/State.h"
+#include "../Header/Telemetry.h"
+#include "../Header/TripleBuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Immutable view of the simulation, published after every batch of ticks.
+struct SimSnapshot
+{
+    std::vector<AppState> units; // unit 0 is the one shown in single-unit mode
+    std::uint64_t tick = 0;
+    double time = 0.0; // simulated seconds
+};
+
+// Runs updateVent/updateTemperature/updateWater for every unit at a fixed tick
+// rate on its own thread. The render thread reads the newest snapshot through a triple buffer
+// and sends input back through an SPSC queue, so neither side waits on the other.
+class SimulationThread
+{
+public:
+    SimulationThread(TelemetryRing& telemetry, std::unique_ptr<ThermostatController> controller, double tickHz = 1000.0);
+    // One controller per unit; missing ones fall back to bang-bang. Telemetry follows unit 0.
+    SimulationThread(TelemetryRing& telemetry, std::vector<AppState> units, std::vector<std::unique_ptr<ThermostatController>> controllers, double tickHz = 1000.0);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Optional; set before start(). Each tick's cost is recorded as ProfilePhase::Simulation.
+    void setProfiler(FrameProfiler* profiler) { m_profiler = profiler; }
+    // Optional; set before start(). While every unit is at rest the thread sleeps until
+    // input arrives instead of ticking, so an idle simulator does not wake the CPU.
+    void setIdleWhenAtRest(bool idle) { m_idleWhenAtRest = idle; }
+
+    void start();
+    void stop();
+
+    // Runs ticks synchronously on the calling thread and publishes the result, for
+    // deterministic headless runs. Only valid while the thread is not started.
+    void advance(int ticks);
+
+    using Clock = std::chrono::steady_clock;
+
+    // Render thread only. The command is applied to the given unit by the first tick
+    // scheduled at or after its timestamp. False if the queue is full and it was dropped.
+    bool pushInput(InputCommand command, Clock::time_point timestamp = Clock::now(), std::size_t unit = 0);
+
+    // Render thread only. Switches to the newest snapshot; true if it changed.
+    bool updateSnapshot() { return m_snapshots.update(); }
+    const SimSnapshot& snapshot() const { return m_snapshots.front(); }
+
+private:
+    struct TimedInput
+    {
+        InputCommand command = InputCommand::TogglePower;
+        Clock::time_point timestamp;
+        std::size_t unit = 0;
+    };
+
+    void run();
+    void tick(float deltaTime, Clock::time_point scheduledAt);
+    void publish();
+    void wake();
+    bool allAtRest() const;
+
+    TelemetryRing& m_telemetry;
+    std::vector<std::unique_ptr<ThermostatController>> m_controllers;
+    std::unique_ptr<MpcBatch> m_mpcBatch; // set when every unit runs the MPC
+    double m_tickSeconds;
+    FrameProfiler* m_profiler = nullptr;
+    bool m_idleWhenAtRest = false;
+
+    SimSnapshot m_current; // owned by the simulation thread
+    TripleBuffer<SimSnapshot> m_snapshots;
+    SpscQueue<TimedInput, 256> m_inputs;
+    TimedInput m_heldInput; // popped but stamped after the current tick
+    bool m_hasHeldInput = false;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{ false };
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_wakePending = false; // guarded by m_wakeMutex; set by pushInput() and stop()
+};
@@ -22,8 +22,21 @@ struct AppState
     bool prevSpacePressed = false;
 };
 
+// Discrete user actions, already hit-tested and edge-detected by the input side.
+enum class InputCommand
+{
+    TogglePower,
+    TemperatureUp,
+    TemperatureDown,
+    DrainBowl
+};
+
+void applyInputCommand(AppState& state, InputCommand command);
 void handlePowerToggle(AppState& state, double mouseX, double mouseY, bool mouseDown, const CircleShape& lamp);
 void updateVent(AppState& state, float deltaTime);
 void handleTemperatureInput(AppState& state, bool upPressed, bool downPressed);
 void updateTemperature(AppState& state, float deltaTime);
 void updateWater(AppState& state, float deltaTime, bool spacePressed);
+
+// Off (or locked) with the vent fully closed: no tick changes the state until new input.
+bool isAtRest(const AppState& state);
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../Header/State.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// One simulation tick worth of recorded state.
+struct TelemetrySample
+{
+    std::uint64_t tick = 0;
+    double time = 0.0; // seconds since simulation start
+    float currentTemp = 0.0f;
+    float desiredTemp = 0.0f;
+    float ventOpenness = 0.0f;
+    float waterLevel = 0.0f;
+    bool isOn = false;
+    bool lockedByFullBowl = false;
+};
+
+TelemetrySample makeTelemetrySample(const AppState& state, std::uint64_t tick, double time);
+
+// Single-producer / multi-consumer history ring. The producer never blocks and
+// overwrites the oldest samples; each slot is guarded by a sequence counter so
+// readers detect torn or overwritten slots instead of locking.
+class TelemetryRing
+{
+public:
+    // Capacity is rounded up to a power of two.
+    explicit TelemetryRing(std::size_t capacity = 1u << 16);
+
+    TelemetryRing(const TelemetryRing&) = delete;
+    TelemetryRing& operator=(const TelemetryRing&) = delete;
+
+    // Producer thread only.
+    void push(const TelemetrySample& sample);
+
+    // Total number of samples pushed so far; sample n has sequence number n.
+    std::uint64_t published() const;
+    std::size_t capacity() const { return m_mask + 1; }
+
+    // Copies sample seq; false if it was not written yet or has been overwritten.
+    bool read(std::uint64_t seq, TelemetrySample& out) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> version{ 0 }; // 2*seq+1 while writing, 2*seq+2 when complete
+        TelemetrySample sample;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask = 0;
+    char m_pad[64] = {}; // keep the hot head counter off the slot pointer's cache line
+    std::atomic<std::uint64_t> m_head{ 0 };
+};
+
+// Independent cursor into a TelemetryRing; each consumer owns one.
+class TelemetryReader
+{
+public:
+    // Starts at the oldest retained sample, or at the current head if fromLatest.
+    explicit TelemetryReader(const TelemetryRing& ring, bool fromLatest = false);
+
+    // Copies up to maxCount unread samples in order and returns how many were copied.
+    std::size_t poll(TelemetrySample* out, std::size_t maxCount);
+
+    // Samples that were overwritten before this reader got to them.
+    std::uint64_t dropped() const { return m_dropped; }
+
+private:
+    const TelemetryRing* m_ring = nullptr;
+    std::uint64_t m_cursor = 0;
+    std::uint64_t m_dropped = 0;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Header/Telemetry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Columns stored by the compressed run log, in on-disk order.
+enum class TelemetryColumn
+{
+    Time, // delta-of-delta microseconds
+    CurrentTemp, // XOR-compressed floats
+    DesiredTemp,
+    VentOpenness,
+    WaterLevel,
+    IsOn, // run-length encoded flags
+    LockedByFullBowl,
+    Count
+};
+
+// Columnar writer: rows are buffered into blocks and every column of a block is
+// encoded separately, so a reader can seek past the columns it does not need.
+//
+// Layout: "ACTL" | u32 version | u32 columnCount, then per block:
+// u32 rowCount | u32 byteLength[columnCount] | column payloads.
+class TelemetryLogWriter
+{
+public:
+    explicit TelemetryLogWriter(std::size_t rowsPerBlock = 4096);
+    ~TelemetryLogWriter();
+
+    TelemetryLogWriter(const TelemetryLogWriter&) = delete;
+    TelemetryLogWriter& operator=(const TelemetryLogWriter&) = delete;
+
+    bool open(const std::string& path);
+    void append(const TelemetrySample& sample);
+    bool flush(); // encodes and writes the pending partial block
+    void close();
+    bool isOpen() const { return m_file.is_open(); }
+
+private:
+    std::ofstream m_file;
+    std::size_t m_rowsPerBlock;
+    std::vector<TelemetrySample> m_pending;
+    std::vector<std::uint8_t> m_columns[static_cast<int>(TelemetryColumn::Count)];
+};
+
+// Streaming reader; each call walks the file block by block and decodes only the
+// requested column, handing every decoded block to the callback.
+class TelemetryLogReader
+{
+public:
+    bool open(const std::string& path);
+
+    bool readTimes(const std::function<void(const double* values, std::size_t count)>& onBlock);
+    bool readFloats(TelemetryColumn column, const std::function<void(const float* values, std::size_t count)>& onBlock);
+    bool readFlags(TelemetryColumn column, const std::function<void(const std::uint8_t* values, std::size_t count)>& onBlock);
+
+    // Convenience wrappers that append the whole column to a vector.
+    bool readTimes(std::vector<double>& out);
+    bool readFloats(TelemetryColumn column, std::vector<float>& out);
+    bool readFlags(TelemetryColumn column, std::vector<std::uint8_t>& out);
+
+private:
+    bool readColumnBlocks(TelemetryColumn column, const std::function<bool(const std::vector<std::uint8_t>& bytes, std::uint32_t rows)>& onBlock);
+
+    std::ifstream m_file;
+    std::uint32_t m_columnCount = 0;
+    std::streamoff m_firstBlock = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../Header/Renderer2D.h"
+#include "../Header/Telemetry.h"
+
+#include <cstdint>
+#include <vector>
+
+// Scrolling currentTemp/desiredTemp plot over the last N seconds. Samples are
+// min/max-decimated into one bucket per pixel column as they arrive, so drawing
+// costs O(width) no matter how many ticks the window covers.
+class TemperatureGraph
+{
+public:
+    explicit TemperatureGraph(const TelemetryRing& ring, double windowSeconds = 600.0);
+
+    // Drains new samples from the telemetry ring into the column buckets.
+    // Returns true if any bucket changed, i.e. the plot needs redrawing.
+    bool update();
+    void draw(Renderer2D& renderer, const RectShape& area, const Color& currentColor, const Color& desiredColor);
+
+    void setWindowSeconds(double seconds);
+    double windowSeconds() const { return m_windowSeconds; }
+
+private:
+    struct Bucket
+    {
+        std::int64_t index = -1; // absolute column index; -1 while empty
+        float currentMin = 0.0f;
+        float currentMax = 0.0f;
+        float desiredMin = 0.0f;
+        float desiredMax = 0.0f;
+    };
+
+    void setColumns(int columns);
+    bool addSample(const TelemetrySample& sample);
+    void appendSeries(const RectShape& area, std::int64_t firstIndex, bool desired, float minTemp, float maxTemp, const Color& color);
+
+    TelemetryReader m_reader;
+    double m_windowSeconds;
+    double m_columnSeconds = 1.0;
+    double m_latestTime = 0.0;
+    int m_columns = 0;
+    std::vector<Bucket> m_buckets; // ring indexed by column index modulo m_columns
+    std::vector<TelemetrySample> m_incoming;
+    std::vector<float> m_points;
+    std::vector<LineStrip> m_strips;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Header/Renderer2D.h"
+#include "../Header/ShaderManager.h"
 
 #include <GL/glew.h>
 #include <map>
@@ -17,6 +18,8 @@ struct Glyph
     unsigned int advance = 0;
 };
 
+class RenderQueue;
+
 struct TextMetrics
 {
     float width = 0.0f;
@@ -32,6 +35,8 @@ public:
 
     bool loadFont(const std::string& fontPath, unsigned int pixelHeight = 48);
     void setWindowSize(float width, float height);
+    // While a queue is set drawText records into it instead of drawing (see Renderer2D::setQueue).
+    void setQueue(RenderQueue* queue) { m_queue = queue; }
 
     // Draw text with origin at top-left corner of the first glyph box.
     void drawText(const std::string& text, float x, float y, float scale, const Color& color);
@@ -41,13 +46,18 @@ public:
 private:
     void cleanup();
     void destroyGlyphTextures();
+    // Binds the program behind m_shader; uniform locations are refreshed when it is first
+    // used and whenever a hot reload replaces it.
+    void useProgram();
 
     float m_windowWidth = 0.0f;
     float m_windowHeight = 0.0f;
     unsigned int m_fontPixelHeight = 0;
     std::string m_fontPath;
+    RenderQueue* m_queue = nullptr;
 
-    GLuint m_program = 0;
+    ShaderManager::Handle m_shader = ShaderManager::kInvalidHandle;
+    unsigned int m_shaderVersion = ~0u; // version the uniform locations belong to
     GLuint m_vao = 0;
     GLuint m_vbo = 0;
     GLint m_uTextColor = -1;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loads image files into GL textures without stalling the frame. Files are
+// decoded by a small pool of worker threads; the GL thread then uploads them
+// through a pixel buffer object, a band of rows at a time, for at most the
+// budget it passes to update() each frame. A handle is usable as soon as
+// load() returns: until its image is uploaded it names a placeholder texture.
+// Nothing is created (threads, placeholder, buffer) until the first load().
+//
+// Rows are uploaded in file order (top row first), without the vertical flip
+// loadImageToTexture does on the CPU, so v = 0 is the top of the image:
+// draw these textures with the v coordinate flipped.
+class TextureLoader
+{
+public:
+    using Handle = int;
+    static constexpr Handle kInvalidHandle = -1;
+
+    ~TextureLoader();
+
+    // GL thread, context current. Queues the file for decoding; the same path always
+    // returns the same handle. The first call starts the decode threads.
+    Handle load(const std::string& path);
+
+    // The texture to bind for the handle: the placeholder until it is ready, and
+    // for good if the file could not be loaded. 0 for an invalid handle.
+    GLuint texture(Handle handle) const;
+    bool isReady(Handle handle) const;
+    bool failed(Handle handle) const;
+    // Image size in pixels; 0 until decoded.
+    int width(Handle handle) const;
+    int height(Handle handle) const;
+
+    // Once per frame on the GL thread: uploads decoded images until budgetSeconds
+    // have passed (always at least one band). Returns true if a texture became ready.
+    bool update(double budgetSeconds);
+
+    // Stops the workers and deletes every texture; all handles become invalid.
+    void clear();
+
+private:
+    enum class Status { Decoding, Uploading, Ready, Failed };
+
+    struct ImageDeleter
+    {
+        void operator()(unsigned char* pixels) const;
+    };
+    using ImageData = std::unique_ptr<unsigned char, ImageDeleter>;
+
+    struct Entry
+    {
+        std::string path;
+        Status status = Status::Decoding;
+        GLuint texture = 0; // only set once the whole image is uploaded
+        int width = 0;
+        int height = 0;
+    };
+
+    struct Job
+    {
+        Handle handle;
+        std::string path;
+    };
+
+    struct Decoded
+    {
+        Handle handle = kInvalidHandle;
+        ImageData pixels;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        GLuint texture = 0; // storage allocated, rows below nextRow uploaded
+        int nextRow = 0;
+    };
+
+    // Creates the placeholder and the upload buffer and starts the decode threads.
+    void start();
+    void workerLoop();
+    void stopWorkers();
+    // Uploads the next band of rows; returns true when the image is complete.
+    bool uploadBand(Decoded& upload);
+
+    std::vector<Entry> m_entries; // GL thread only
+    std::deque<Decoded> m_uploads; // GL thread only
+    GLuint m_placeholder = 0;
+    GLuint m_pbo = 0;
+
+    // Shared with the workers.
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Job> m_jobs;
+    std::vector<Decoded> m_decoded;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
+
+// Process-wide loader shared by the renderers and main().
+TextureLoader& textureLoader();
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+// Event tracing for field stutter reports. Compiled in only when
+// AC_ENABLE_TRACING is defined (the Debug|x64 configuration does); otherwise
+// every macro expands to nothing and the functions are empty inlines.
+//
+// Each thread appends begin/end events to its own fixed-size ring, so
+// recording takes no locks and never allocates; when a ring wraps, the oldest
+// events are overwritten. traceWriteChromeJson merges all rings into a Chrome
+// trace-event JSON file, which chrome://tracing and the Perfetto UI both open.
+// Event names must be string literals (only the pointer is stored).
+
+#ifdef AC_ENABLE_TRACING
+
+void traceBegin(const char* name);
+void traceEnd();
+// Labels the calling thread in the trace viewer.
+void traceSetThreadName(const char* name);
+bool traceWriteChromeJson(const std::string& path);
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) { traceBegin(name); }
+    ~TraceScope() { traceEnd(); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define AC_TRACE_CONCAT_INNER(a, b) a##b
+#define AC_TRACE_CONCAT(a, b) AC_TRACE_CONCAT_INNER(a, b)
+#define AC_TRACE_SCOPE(name) TraceScope AC_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define AC_TRACE_BEGIN(name) traceBegin(name)
+#define AC_TRACE_END() traceEnd()
+
+#else
+
+inline void traceSetThreadName(const char*) {}
+inline bool traceWriteChromeJson(const std::string&) { return false; }
+
+#define AC_TRACE_SCOPE(name) ((void)0)
+#define AC_TRACE_BEGIN(name) ((void)0)
+#define AC_TRACE_END() ((void)0)
+
+#endif
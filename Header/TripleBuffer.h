@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+
+// Lock-free single-writer / single-reader triple buffer. The writer always has a
+// private slot to fill, the reader always holds a complete one, and publishing
+// swaps the filled slot into the shared middle position. The reader sees the
+// newest published value and never waits; skipped intermediate values are dropped.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Writer side: fill back(), then publish() it.
+    T& back() { return m_slots[m_back]; }
+
+    void publish()
+    {
+        int previous = m_middle.exchange(m_back | kFreshBit, std::memory_order_acq_rel);
+        m_back = previous & kIndexMask;
+    }
+
+    // Reader side: switches front() to the newest published value; false if nothing new.
+    bool update()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & kFreshBit) == 0) return false;
+        int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & kIndexMask;
+        return true;
+    }
+
+    // Stays valid and unchanged until the next update().
+    const T& front() const { return m_slots[m_front]; }
+
+private:
+    static const int kIndexMask = 3;
+    static const int kFreshBit = 4;
+
+    T m_slots[3];
+    int m_back = 0;
+    std::atomic<int> m_middle{ 1 };
+    int m_front = 2;
+};
@@ -3,6 +3,7 @@
 #include <GLFW/glfw3.h>
 #include <string>
 int endProgram(std::string message);
+std::string readShaderSource(const char* source);
 unsigned int createShader(const char* vsSource, const char* fsSource);
 unsigned loadImageToTexture(const char* filePath);
 GLFWcursor* loadImageToCursor(const char* filePath);
@@ -0,0 +1,483 @@
+#include "../Header/Benchmark.h"
+
+#include "../Header/Controller.h"
+#include "../Header/Dashboard.h"
+#include "../Header/GlState.h"
+#include "../Header/SceneLayout.h"
+#include "../Header/State.h"
+#include "../Header/TemperatureUI.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef AC_BENCH_ALLOC_COUNT
+
+namespace
+{
+    std::atomic<std::uint64_t> g_allocations{ 0 };
+
+    void* countedAlloc(std::size_t size, const std::nothrow_t&) noexcept
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+
+    void* countedAlloc(std::size_t size)
+    {
+        if (void* p = countedAlloc(size, std::nothrow)) return p;
+        throw std::bad_alloc();
+    }
+
+#ifdef __cpp_aligned_new
+    void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, static_cast<std::size_t>(alignment));
+#else
+        void* p = nullptr;
+        return posix_memalign(&p, static_cast<std::size_t>(alignment), size ? size : 1) == 0 ? p : nullptr;
+#endif
+    }
+
+    void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+    {
+        if (void* p = countedAlignedAlloc(size, alignment, std::nothrow)) return p;
+        throw std::bad_alloc();
+    }
+
+    void alignedFree(void* p) noexcept
+    {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+#endif
+}
+
+// Global replacements so the benchmark can see every allocation made while drawing.
+// Only in builds that define AC_BENCH_ALLOC_COUNT: they put an atomic add on every
+// allocation of every thread and bypass the CRT's own operator new.
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept { return countedAlloc(size, tag); }
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return countedAlloc(size, tag); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { return countedAlignedAlloc(size, alignment, tag); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { return countedAlignedAlloc(size, alignment, tag); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+#endif
+
+std::uint64_t allocationCount()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+std::uint64_t allocationCount()
+{
+    return 0;
+}
+
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    volatile float g_measureSink = 0.0f; // keeps measure() results from being optimized away
+
+    struct BenchCase
+    {
+        const char* name;
+        int maxPrimitives; // expensive cases stop earlier
+        std::function<void(int count)> run;
+    };
+
+    // Deterministic scene: positions, sizes and temperatures from a fixed LCG seed.
+    struct SyntheticScene
+    {
+        std::vector<float> x, y, size, desired, current;
+        std::vector<std::string> labels;
+
+        SyntheticScene(int count, int width, int height)
+        {
+            std::uint32_t state = 12345u;
+            auto next = [&state]()
+            {
+                state = state * 1664525u + 1013904223u;
+                return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+            };
+
+            x.resize(count);
+            y.resize(count);
+            size.resize(count);
+            desired.resize(count);
+            current.resize(count);
+            labels.resize(count);
+            for (int i = 0; i < count; ++i)
+            {
+                size[i] = 4.0f + next() * 60.0f;
+                x[i] = next() * std::max(static_cast<float>(width) - size[i], 1.0f);
+                y[i] = next() * std::max(static_cast<float>(height) - size[i], 1.0f);
+                desired[i] = 16.0f + next() * 14.0f;
+                current[i] = 16.0f + next() * 14.0f;
+
+                char label[16];
+                std::snprintf(label, sizeof(label), "%.1f C", current[i]);
+                labels[i] = label;
+            }
+        }
+    };
+
+    void runCase(const BenchCase& bench, int count, double minSeconds)
+    {
+        // Warm-up pass: first-use uploads and driver work stay out of the numbers.
+        bench.run(count);
+        glFinish();
+
+        std::uint64_t allocsBefore = allocationCount();
+        double cpuSeconds = 0.0;
+        long long iterations = 0;
+        Clock::time_point start = Clock::now();
+        Clock::time_point now = start;
+        do
+        {
+            Clock::time_point submitStart = Clock::now();
+            bench.run(count);
+            now = Clock::now();
+            cpuSeconds += std::chrono::duration<double>(now - submitStart).count();
+            ++iterations;
+        } while (std::chrono::duration<double>(now - start).count() < minSeconds);
+        glFinish();
+        double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::uint64_t allocs = allocationCount() - allocsBefore;
+
+        double primitives = static_cast<double>(count) * static_cast<double>(iterations);
+        char allocText[32] = "-";
+        if (kCountsAllocations)
+        {
+            std::snprintf(allocText, sizeof(allocText), "%.1f", static_cast<double>(allocs) / static_cast<double>(iterations));
+        }
+        std::printf("%-14s %8d %9lld %14.0f %11.1f %12s\n",
+            bench.name, count, iterations,
+            primitives / std::max(wallSeconds, 1e-9),
+            cpuSeconds * 1e9 / primitives,
+            allocText);
+    }
+}
+
+void runRenderBenchmarks(Renderer2D& renderer, TextRenderer& textRenderer, int width, int height, const RenderBenchOptions& options)
+{
+    const int maxPrimitives = std::max(options.maxPrimitives, 1);
+    SyntheticScene scene(maxPrimitives, width, height);
+    const Color fill{ 0.35f, 0.70f, 0.90f, 1.0f };
+    const Color textColor{ 0.96f, 0.98f, 1.0f, 1.0f };
+    const Color textBg{ 0.08f, 0.08f, 0.10f, 1.0f };
+
+    std::vector<BenchCase> cases;
+    cases.push_back({ "rect", maxPrimitives, [&](int count)
+    {
+        for (int i = 0; i < count; ++i) renderer.drawRect(scene.x[i], scene.y[i], scene.size[i], scene.size[i], fill);
+    } });
+    cases.push_back({ "circle", maxPrimitives, [&](int count)
+    {
+        for (int i = 0; i < count; ++i) renderer.drawCircle(scene.x[i], scene.y[i], scene.size[i] * 0.5f, fill);
+    } });
+    cases.push_back({ "triangle", maxPrimitives, [&](int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            float s = scene.size[i];
+            renderer.drawTriangle(scene.x[i], scene.y[i] + s, scene.x[i] + s * 0.5f, scene.y[i], scene.x[i] + s, scene.y[i] + s, fill);
+        }
+    } });
+    cases.push_back({ "status icon", maxPrimitives, [&](int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            RectShape screen{ scene.x[i], scene.y[i], scene.size[i] * 1.6f, scene.size[i], fill };
+            drawStatusIcon(renderer, screen, scene.desired[i], scene.current[i]);
+        }
+    } });
+    cases.push_back({ "text draw", std::min(maxPrimitives, 10000), [&](int count)
+    {
+        for (int i = 0; i < count; ++i) textRenderer.drawText(scene.labels[i], scene.x[i], scene.y[i], 0.4f, textColor);
+    } });
+    cases.push_back({ "text value", std::min(maxPrimitives, 10000), [&](int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            RectShape screen{ scene.x[i], scene.y[i], kUnitScreenW, kUnitScreenH, fill };
+            drawTemperatureValue(textRenderer, scene.current[i], screen, textColor);
+        }
+    } });
+    cases.push_back({ "text measure", maxPrimitives, [&](int count)
+    {
+        float total = 0.0f;
+        for (int i = 0; i < count; ++i) total += textRenderer.measure(scene.labels[i], 0.4f).width;
+        g_measureSink = g_measureSink + total;
+    } });
+    cases.push_back({ "text texture", std::min(maxPrimitives, 100), [&](int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            GLuint texture = 0;
+            int w = 0;
+            int h = 0;
+            if (textRenderer.createTextTexture(scene.labels[i], textColor, textBg, 4, 32, texture, w, h))
+            {
+                glState().forgetTexture(texture);
+                glDeleteTextures(1, &texture);
+            }
+        }
+    } });
+
+    std::printf("Render benchmark on %s (%dx%d)\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)), width, height);
+    std::printf("%-14s %8s %9s %14s %11s %12s\n", "case", "prims", "passes", "draws/s", "cpu ns/prim", "allocs/pass");
+    for (const BenchCase& bench : cases)
+    {
+        for (int count = 1; count <= bench.maxPrimitives; count *= 10)
+        {
+            glClear(GL_COLOR_BUFFER_BIT);
+            runCase(bench, count, options.minSeconds);
+        }
+    }
+    std::fflush(stdout);
+}
+
+namespace
+{
+    constexpr float kSimDeltaTime = 0.001f; // the default 1 kHz tick
+    constexpr int kSimRoundTicks = 256;     // units are reset between rounds so none settles or fills up
+    constexpr int kSimRepetitions = 3;      // best of, to ride out scheduler noise
+
+    struct SimCase
+    {
+        std::string name;
+        std::function<void(std::vector<AppState>& units, int tick)> run;
+    };
+
+    struct SimResult
+    {
+        std::string name;
+        int batch = 0;
+        double ticksPerSecond = 0.0; // unit-ticks: one unit advanced by one tick
+    };
+
+    double measureSimCase(const SimCase& bench, const std::vector<AppState>& initial, double minSeconds)
+    {
+        std::vector<AppState> units = initial;
+        double best = 0.0;
+        for (int rep = 0; rep < kSimRepetitions; ++rep)
+        {
+            double seconds = 0.0;
+            long long unitTicks = 0;
+            while (seconds < minSeconds)
+            {
+                units = initial;
+                Clock::time_point start = Clock::now();
+                for (int tick = 0; tick < kSimRoundTicks; ++tick)
+                {
+                    bench.run(units, tick);
+                }
+                seconds += std::chrono::duration<double>(Clock::now() - start).count();
+                unitTicks += static_cast<long long>(kSimRoundTicks) * static_cast<long long>(units.size());
+            }
+            best = std::max(best, static_cast<double>(unitTicks) / seconds);
+        }
+        return best;
+    }
+
+    std::string simResultKey(const std::string& name, int batch)
+    {
+        return name + "/" + std::to_string(batch);
+    }
+
+    // Reads the one-result-per-line files written by writeSimJson.
+    bool readSimBaseline(const std::string& path, std::map<std::string, double>& out)
+    {
+        std::ifstream in(path);
+        if (!in) return false;
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            char name[64] = {};
+            int batch = 0;
+            double ticksPerSecond = 0.0;
+            if (std::sscanf(line.c_str(), " {\"name\": \"%63[^\"]\", \"batch\": %d, \"ticksPerSecond\": %lf", name, &batch, &ticksPerSecond) == 3)
+            {
+                out[simResultKey(name, batch)] = ticksPerSecond;
+            }
+        }
+        return true;
+    }
+
+    bool writeSimJson(const std::string& path, const std::vector<SimResult>& results)
+    {
+        std::ofstream out(path);
+        if (!out) return false;
+
+        out << "{\"benchmark\": \"simulation\", \"deltaTime\": " << kSimDeltaTime << ", \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            char line[192];
+            std::snprintf(line, sizeof(line), "  {\"name\": \"%s\", \"batch\": %d, \"ticksPerSecond\": %.1f, \"nsPerUnitTick\": %.3f}%s\n",
+                results[i].name.c_str(), results[i].batch, results[i].ticksPerSecond, 1e9 / results[i].ticksPerSecond,
+                i + 1 < results.size() ? "," : "");
+            out << line;
+        }
+        out << "]}\n";
+        return static_cast<bool>(out);
+    }
+}
+
+int runSimulationBenchmarks(const SimBenchOptions& options)
+{
+#ifdef AC_ENABLE_TRACING
+    std::printf("Warning: built with AC_ENABLE_TRACING, numbers include trace overhead.\n");
+#endif
+
+    const int batches[] = { 1, 16, 256, 4096 };
+    const char* controllerNames[] = { "bangbang", "pid", "mpc" };
+    std::vector<std::unique_ptr<ThermostatController>> controllers;
+    MpcBatch mpcBatch;
+
+    std::vector<SimCase> cases;
+    cases.push_back({ "updateVent", [](std::vector<AppState>& units, int)
+    {
+        for (AppState& state : units) updateVent(state, kSimDeltaTime);
+    } });
+    cases.push_back({ "updateTemperature", [](std::vector<AppState>& units, int)
+    {
+        for (AppState& state : units) updateTemperature(state, kSimDeltaTime);
+    } });
+    for (const char* controllerName : controllerNames)
+    {
+        cases.push_back({ std::string("updateTemperature/") + controllerName, [&controllers](std::vector<AppState>& units, int)
+        {
+            for (size_t i = 0; i < units.size(); ++i) updateTemperature(units[i], kSimDeltaTime, *controllers[i]);
+        } });
+    }
+    // What the simulation runs when every unit uses the MPC: one solveBatch call per tick.
+    cases.push_back({ "updateTemperature/mpc-batched", [&mpcBatch](std::vector<AppState>& units, int)
+    {
+        mpcBatch.updateTemperatures(units, kSimDeltaTime);
+    } });
+    cases.push_back({ "updateWater", [](std::vector<AppState>& units, int)
+    {
+        for (AppState& state : units) updateWater(state, kSimDeltaTime, false);
+    } });
+    cases.push_back({ "handleTemperatureInput", [](std::vector<AppState>& units, int tick)
+    {
+        // Press and release up, then down, so every other call sees an edge.
+        bool up = (tick & 3) == 0;
+        bool down = (tick & 3) == 2;
+        for (AppState& state : units) handleTemperatureInput(state, up, down);
+    } });
+    cases.push_back({ "tick", [&controllers](std::vector<AppState>& units, int)
+    {
+        for (size_t i = 0; i < units.size(); ++i)
+        {
+            updateVent(units[i], kSimDeltaTime);
+            updateTemperature(units[i], kSimDeltaTime, *controllers[i]);
+            updateWater(units[i], kSimDeltaTime, false);
+        }
+    } });
+    cases.push_back({ "tick/mpc-batched", [&mpcBatch](std::vector<AppState>& units, int)
+    {
+        for (AppState& state : units) updateVent(state, kSimDeltaTime);
+        mpcBatch.updateTemperatures(units, kSimDeltaTime);
+        for (AppState& state : units) updateWater(state, kSimDeltaTime, false);
+    } });
+
+    std::vector<SimResult> results;
+    std::printf("%-32s %6s %16s %12s\n", "case", "batch", "unit-ticks/s", "ns/unit-tick");
+    for (SimCase& bench : cases)
+    {
+        // The controller cases share one slot per unit; "tick" uses the default bangbang.
+        // The batched cases bring their own solver and leave the slots empty.
+        std::string controllerName = "bangbang";
+        size_t slash = bench.name.find('/');
+        if (slash != std::string::npos) controllerName = bench.name.substr(slash + 1);
+        bool batched = controllerName == "mpc-batched";
+
+        for (int batch : batches)
+        {
+            controllers.clear();
+            if (!batched)
+            {
+                for (int i = 0; i < batch; ++i) controllers.push_back(createController(controllerName));
+            }
+            mpcBatch = MpcBatch();
+
+            std::vector<AppState> initial = makeDashboardUnits(batch);
+            for (AppState& state : initial) state.isOn = true;
+
+            SimResult result;
+            result.name = bench.name;
+            result.batch = batch;
+            result.ticksPerSecond = measureSimCase(bench, initial, options.minSeconds);
+            results.push_back(result);
+            std::printf("%-32s %6d %16.0f %12.2f\n", result.name.c_str(), batch, result.ticksPerSecond, 1e9 / result.ticksPerSecond);
+        }
+    }
+
+    if (!options.jsonPath.empty() && !writeSimJson(options.jsonPath, results))
+    {
+        std::printf("Could not write %s\n", options.jsonPath.c_str());
+        return 2;
+    }
+
+    if (options.baselinePath.empty()) return 0;
+
+    std::map<std::string, double> baseline;
+    if (!readSimBaseline(options.baselinePath, baseline))
+    {
+        std::printf("Could not read baseline %s\n", options.baselinePath.c_str());
+        return 2;
+    }
+
+    int regressions = 0;
+    std::printf("\nAgainst %s (limit -%.1f%%):\n", options.baselinePath.c_str(), options.maxRegressionPercent);
+    for (const SimResult& result : results)
+    {
+        auto it = baseline.find(simResultKey(result.name, result.batch));
+        if (it == baseline.end() || it->second <= 0.0) continue;
+
+        double change = (result.ticksPerSecond - it->second) / it->second * 100.0;
+        bool regressed = change < -options.maxRegressionPercent;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-32s %6d %+8.1f%%%s\n", result.name.c_str(), result.batch, change, regressed ? "  REGRESSION" : "");
+    }
+    std::printf("%d regression(s)\n", regressions);
+    return regressions > 0 ? 1 : 0;
+}
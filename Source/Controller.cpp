@@ -0,0 +1,206 @@
+#include "../Header/Controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    float clampDrive(float drive)
+    {
+        if (drive < -1.0f) return -1.0f;
+        if (drive > 1.0f) return 1.0f;
+        return drive;
+    }
+}
+
+float BangBangController::computeDrive(const AppState& state, float deltaTime)
+{
+    // Full power toward the target; scale down on the last step so we land on it.
+    float diff = state.desiredTemp - state.currentTemp;
+    float step = state.tempDriftSpeed * deltaTime;
+    if (step <= 0.0f) return 0.0f;
+
+    if (std::fabs(diff) <= step)
+    {
+        return diff / step;
+    }
+    return diff > 0.0f ? 1.0f : -1.0f;
+}
+
+PidController::PidController(const PidGains& gains)
+    : m_gains(gains)
+{
+}
+
+void PidController::reset()
+{
+    m_integral = 0.0f;
+    m_prevMeasurement = 0.0f;
+    m_hasPrev = false;
+}
+
+float PidController::computeDrive(const AppState& state, float deltaTime)
+{
+    if (deltaTime <= 0.0f) return 0.0f;
+
+    float error = state.desiredTemp - state.currentTemp;
+    m_integral = std::max(-m_gains.integralLimit, std::min(m_gains.integralLimit, m_integral + error * deltaTime));
+
+    // Derivative on measurement so setpoint steps don't kick the output.
+    float derivative = 0.0f;
+    if (m_hasPrev)
+    {
+        derivative = -(state.currentTemp - m_prevMeasurement) / deltaTime;
+    }
+    m_prevMeasurement = state.currentTemp;
+    m_hasPrev = true;
+
+    return clampDrive(m_gains.kp * error + m_gains.ki * m_integral + m_gains.kd * derivative);
+}
+
+MpcController::MpcController(const MpcConfig& config)
+    : m_config(config)
+{
+    int count = std::max(2, m_config.candidateCount);
+    m_config.candidateCount = count;
+
+    // Fixed levels plus one per-unit slot for the drive that lands exactly on the target.
+    m_candidateDrives.resize(static_cast<size_t>(count) + 1);
+    m_candidateEffort.resize(m_candidateDrives.size());
+    for (int i = 0; i < count; ++i)
+    {
+        float drive = -1.0f + 2.0f * static_cast<float>(i) / static_cast<float>(count - 1);
+        m_candidateDrives[i] = drive;
+        m_candidateEffort[i] = m_config.effortWeight * drive * drive * static_cast<float>(m_config.horizonSteps);
+    }
+    m_predicted.resize(m_candidateDrives.size());
+    m_cost.resize(m_candidateDrives.size());
+}
+
+void MpcController::reset()
+{
+    m_lastDrive = 0.0f;
+}
+
+float MpcController::computeDrive(const AppState& state, float)
+{
+    float drive = 0.0f;
+    solveBatch(&state.currentTemp, &state.desiredTemp, &state.tempDriftSpeed, &m_lastDrive, &drive, 1);
+    m_lastDrive = drive;
+    return drive;
+}
+
+void MpcController::solveBatch(const float* currentTemps, const float* desiredTemps, const float* driftSpeeds,
+    const float* previousDrives, float* outDrives, std::size_t unitCount)
+{
+    const size_t candidates = m_candidateDrives.size();
+    const size_t landing = candidates - 1;
+    const int horizon = std::max(1, m_config.horizonSteps);
+    float* drives = m_candidateDrives.data();
+    float* effort = m_candidateEffort.data();
+    float* predicted = m_predicted.data();
+    float* cost = m_cost.data();
+
+    float decaySum = 0.0f;
+    float weight = 1.0f;
+    for (int step = 0; step < horizon; ++step)
+    {
+        decaySum += weight;
+        weight *= m_config.driveDecay;
+    }
+
+    for (size_t unit = 0; unit < unitCount; ++unit)
+    {
+        const float target = desiredTemps[unit];
+        const float start = currentTemps[unit];
+        const float perStep = driftSpeeds[unit] * m_config.stepSeconds;
+        const float prev = previousDrives ? previousDrives[unit] : 0.0f;
+
+        // Extra candidate whose whole trajectory ends exactly on the target.
+        float landingDrive = perStep > 0.0f ? clampDrive((target - start) / (perStep * decaySum)) : 0.0f;
+        drives[landing] = landingDrive;
+        effort[landing] = m_config.effortWeight * landingDrive * landingDrive * static_cast<float>(horizon);
+
+        // Branch-free inner loops over candidates so the compiler can vectorize them.
+        for (size_t c = 0; c < candidates; ++c)
+        {
+            float slew = drives[c] - prev;
+            predicted[c] = start;
+            cost[c] = effort[c] + m_config.slewWeight * slew * slew;
+        }
+
+        float stepScale = perStep;
+        for (int step = 0; step < horizon; ++step)
+        {
+            for (size_t c = 0; c < candidates; ++c)
+            {
+                predicted[c] += drives[c] * stepScale;
+                float error = predicted[c] - target;
+                cost[c] += error * error;
+            }
+            stepScale *= m_config.driveDecay;
+        }
+
+        size_t best = 0;
+        for (size_t c = 1; c < candidates; ++c)
+        {
+            if (cost[c] < cost[best]) best = c;
+        }
+        outDrives[unit] = drives[best];
+    }
+}
+
+MpcBatch::MpcBatch(const MpcConfig& config)
+    : m_solver(config)
+{
+}
+
+void MpcBatch::updateTemperatures(std::vector<AppState>& units, float deltaTime)
+{
+    m_lastDrives.resize(units.size(), 0.0f);
+
+    m_active.clear();
+    m_currentTemps.clear();
+    m_desiredTemps.clear();
+    m_driftSpeeds.clear();
+    m_previousDrives.clear();
+    for (std::size_t i = 0; i < units.size(); ++i)
+    {
+        const AppState& state = units[i];
+        if (!state.isOn || state.lockedByFullBowl) continue;
+        m_active.push_back(i);
+        m_currentTemps.push_back(state.currentTemp);
+        m_desiredTemps.push_back(state.desiredTemp);
+        m_driftSpeeds.push_back(state.tempDriftSpeed);
+        m_previousDrives.push_back(m_lastDrives[i]);
+    }
+    if (m_active.empty()) return;
+
+    m_drives.resize(m_active.size());
+    m_solver.solveBatch(m_currentTemps.data(), m_desiredTemps.data(), m_driftSpeeds.data(),
+        m_previousDrives.data(), m_drives.data(), m_active.size());
+
+    for (std::size_t k = 0; k < m_active.size(); ++k)
+    {
+        AppState& state = units[m_active[k]];
+        float drive = clampDrive(m_drives[k]);
+        m_lastDrives[m_active[k]] = drive;
+        state.currentTemp += drive * state.tempDriftSpeed * deltaTime;
+    }
+}
+
+std::unique_ptr<ThermostatController> createController(const std::string& name)
+{
+    if (name == "bangbang") return std::unique_ptr<ThermostatController>(new BangBangController());
+    if (name == "pid") return std::unique_ptr<ThermostatController>(new PidController());
+    if (name == "mpc") return std::unique_ptr<ThermostatController>(new MpcController());
+    return nullptr;
+}
+
+void updateTemperature(AppState& state, float deltaTime, ThermostatController& controller)
+{
+    if (!state.isOn || state.lockedByFullBowl) return;
+
+    float drive = clampDrive(controller.computeDrive(state, deltaTime));
+    state.currentTemp += drive * state.tempDriftSpeed * deltaTime;
+}
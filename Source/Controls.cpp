@@ -5,6 +5,13 @@ bool pointInRect(double px, double py, const RectShape& rect)
     return px >= rect.x && px <= rect.x + rect.w && py >= rect.y && py <= rect.y + rect.h;
 }
 
+bool pointInCircle(double px, double py, const CircleShape& circle)
+{
+    float dx = static_cast<float>(px) - circle.x;
+    float dy = static_cast<float>(py) - circle.y;
+    return dx * dx + dy * dy <= circle.radius * circle.radius;
+}
+
 void drawHalfArrow(Renderer2D& renderer, const RectShape& button, bool isUp, const Color& arrowColor, const Color& bgColor)
 {
     float cx = button.x + button.w * 0.5f;
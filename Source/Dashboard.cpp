@@ -0,0 +1,316 @@
+#include "../Header/Dashboard.h"
+
+#include "../Header/Controller.h"
+#include "../Header/Controls.h"
+#include "../Header/RenderQueue.h"
+#include "../Header/SceneLayout.h"
+#include "../Header/TemperatureUI.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Grid cell: the unit plus a gutter.
+    const float kCellW = kUnitBodyW + 80.0f;
+    const float kCellH = kUnitBowlY + kUnitBowlH + 60.0f;
+
+    // Level-of-detail thresholds on the on-screen body width, in pixels.
+    const float kQuadLodMaxPx = 64.0f;
+    const float kFullLodMinPx = 260.0f;
+
+    const float kMaxZoom = 4.0f;
+
+    const Color kHeatColor{ 0.96f, 0.46f, 0.28f, 1.0f };
+    const Color kCoolColor{ 0.66f, 0.85f, 0.98f, 1.0f };
+    const Color kOkColor{ 0.38f, 0.92f, 0.58f, 1.0f };
+    const Color kQuadOffColor{ 0.30f, 0.32f, 0.36f, 1.0f };
+    const Color kSelectionColor{ 0.96f, 0.62f, 0.30f, 1.0f };
+
+    enum class Status { Off, Locked, Heat, Cool, Ok };
+
+    Status statusOf(const AppState& state)
+    {
+        if (state.lockedByFullBowl) return Status::Locked;
+        if (!state.isOn) return Status::Off;
+        float diff = state.desiredTemp - state.currentTemp;
+        if (diff > kTemperatureTolerance) return Status::Heat;
+        if (diff < -kTemperatureTolerance) return Status::Cool;
+        return Status::Ok;
+    }
+
+    // Cheap integer hash so the starting states look random but are reproducible.
+    unsigned int mix(unsigned int v)
+    {
+        v ^= v >> 16;
+        v *= 0x7feb352dU;
+        v ^= v >> 15;
+        v *= 0x846ca68bU;
+        v ^= v >> 16;
+        return v;
+    }
+
+    float unitFloat(unsigned int v)
+    {
+        return static_cast<float>(v & 0xffffU) / 65535.0f;
+    }
+}
+
+std::vector<AppState> makeDashboardUnits(int count)
+{
+    std::vector<AppState> units(static_cast<size_t>(std::max(count, 1)));
+    for (size_t i = 0; i < units.size(); ++i)
+    {
+        unsigned int h = mix(static_cast<unsigned int>(i) + 1U);
+        AppState& state = units[i];
+        state.isOn = (h % 3U) != 0U;
+        state.currentTemp = 16.0f + 18.0f * unitFloat(h);
+        state.desiredTemp = std::round(20.0f + 6.0f * unitFloat(h >> 16));
+        state.waterLevel = 0.5f * unitFloat(mix(h));
+        state.waterFillPerSecond = 0.01f + 0.04f * unitFloat(mix(h) >> 16);
+    }
+    return units;
+}
+
+Dashboard::Dashboard(int unitCount, float aspect)
+    : m_unitCount(std::max(unitCount, 1))
+{
+    // Pick a column count that makes the whole grid roughly match the viewport shape.
+    float a = aspect > 0.0f ? aspect : 1.0f;
+    m_columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(m_unitCount) * a * kCellH / kCellW))));
+    m_columns = std::min(m_columns, m_unitCount);
+    m_rows = (m_unitCount + m_columns - 1) / m_columns;
+
+    for (auto& batch : m_batches)
+    {
+        batch.reserve(1024);
+    }
+}
+
+void Dashboard::setViewportSize(float width, float height)
+{
+    m_viewWidth = std::max(width, 1.0f);
+    m_viewHeight = std::max(height, 1.0f);
+
+    float fitZoom = std::min(m_viewWidth / (m_columns * kCellW), m_viewHeight / (m_rows * kCellH));
+    m_minZoom = std::min(fitZoom * 0.5f, 1.0f);
+    m_zoom = std::max(m_zoom, m_minZoom);
+}
+
+void Dashboard::fitAll()
+{
+    float gridW = m_columns * kCellW;
+    float gridH = m_rows * kCellH;
+    m_zoom = std::min(m_viewWidth / gridW, m_viewHeight / gridH);
+    m_zoom = std::min(std::max(m_zoom, m_minZoom), kMaxZoom);
+    m_panX = (m_viewWidth - gridW * m_zoom) * 0.5f;
+    m_panY = (m_viewHeight - gridH * m_zoom) * 0.5f;
+}
+
+void Dashboard::pan(float dx, float dy)
+{
+    m_panX += dx;
+    m_panY += dy;
+}
+
+void Dashboard::zoomAt(float factor, float x, float y)
+{
+    float zoom = std::min(std::max(m_zoom * factor, m_minZoom), kMaxZoom);
+    float worldX = (x - m_panX) / m_zoom;
+    float worldY = (y - m_panY) / m_zoom;
+    m_zoom = zoom;
+    m_panX = x - worldX * m_zoom;
+    m_panY = y - worldY * m_zoom;
+}
+
+int Dashboard::pick(double x, double y, DashboardControl& control) const
+{
+    control = DashboardControl::None;
+
+    double worldX = (x - m_panX) / m_zoom;
+    double worldY = (y - m_panY) / m_zoom;
+    int column = static_cast<int>(std::floor(worldX / kCellW));
+    int row = static_cast<int>(std::floor(worldY / kCellH));
+    if (column < 0 || column >= m_columns || row < 0 || row >= m_rows) return -1;
+
+    int unit = row * m_columns + column;
+    if (unit >= m_unitCount) return -1;
+
+    double localX = worldX - column * kCellW;
+    double localY = worldY - row * kCellH;
+
+    CircleShape lamp{ kUnitLampX, kUnitLampY, kUnitLampR, kUnitLampOnColor };
+    RectShape arrowUp{ kUnitArrowX, kUnitScreenY, kUnitArrowW, kUnitScreenH * 0.5f, kUnitArrowBg };
+    RectShape arrowDown{ kUnitArrowX, kUnitScreenY + kUnitScreenH * 0.5f, kUnitArrowW, kUnitScreenH * 0.5f, kUnitArrowBg };
+    if (pointInCircle(localX, localY, lamp)) control = DashboardControl::Power;
+    else if (pointInRect(localX, localY, arrowUp)) control = DashboardControl::TemperatureUp;
+    else if (pointInRect(localX, localY, arrowDown)) control = DashboardControl::TemperatureDown;
+
+    RectShape body{ 0.0f, 0.0f, kUnitBodyW, kUnitBodyH, kUnitBodyColor };
+    RectShape bowl{ kUnitBowlX, kUnitBowlY, kUnitBowlW, kUnitBowlH, kUnitBowlColor };
+    bool onUnit = control != DashboardControl::None || pointInRect(localX, localY, body) || pointInRect(localX, localY, bowl);
+    return onUnit ? unit : -1;
+}
+
+void Dashboard::pushRect(Slot slot, float x, float y, float w, float h) const
+{
+    std::vector<float>& batch = m_batches[slot];
+    batch.push_back(x);
+    batch.push_back(y);
+    batch.push_back(w);
+    batch.push_back(h);
+}
+
+void Dashboard::batchQuad(const AppState& state, float x, float y) const
+{
+    static const Slot slots[] = { SLOT_QUAD_OFF, SLOT_QUAD_LOCKED, SLOT_QUAD_HEAT, SLOT_QUAD_COOL, SLOT_QUAD_OK };
+    Slot slot = slots[static_cast<int>(statusOf(state))];
+    pushRect(slot, x, y, kUnitBodyW * m_zoom, kUnitBodyH * m_zoom);
+}
+
+void Dashboard::batchFlat(const AppState& state, float x, float y) const
+{
+    const float z = m_zoom;
+    pushRect(SLOT_BODY, x, y, kUnitBodyW * z, kUnitBodyH * z);
+
+    float ventH = kUnitVentClosedH + (kUnitVentOpenH - kUnitVentClosedH) * state.ventOpenness;
+    pushRect(SLOT_VENT, x + kUnitVentX * z, y + kUnitVentY * z, kUnitVentW * z, ventH * z);
+
+    Slot screenSlot = state.isOn ? SLOT_SCREEN_ON : SLOT_SCREEN_OFF;
+    for (int i = 0; i < 3; ++i)
+    {
+        pushRect(screenSlot, x + (kUnitScreenX + i * kUnitScreenStep) * z, y + kUnitScreenY * z, kUnitScreenW * z, kUnitScreenH * z);
+    }
+
+    // The status icon shrinks to a colored square on the third screen.
+    Status status = statusOf(state);
+    if (status == Status::Heat || status == Status::Cool || status == Status::Ok)
+    {
+        Slot statusSlot = status == Status::Heat ? SLOT_STATUS_HEAT : status == Status::Cool ? SLOT_STATUS_COOL : SLOT_STATUS_OK;
+        float iconSize = kUnitScreenH * 0.5f;
+        float iconX = kUnitScreenX + 2 * kUnitScreenStep + (kUnitScreenW - iconSize) * 0.5f;
+        float iconY = kUnitScreenY + (kUnitScreenH - iconSize) * 0.5f;
+        pushRect(statusSlot, x + iconX * z, y + iconY * z, iconSize * z, iconSize * z);
+    }
+
+    pushRect(state.isOn ? SLOT_LAMP_ON : SLOT_LAMP_OFF, x + (kUnitLampX - kUnitLampR) * z, y + (kUnitLampY - kUnitLampR) * z, 2.0f * kUnitLampR * z, 2.0f * kUnitLampR * z);
+    pushRect(SLOT_ARROW, x + kUnitArrowX * z, y + kUnitScreenY * z, kUnitArrowW * z, kUnitScreenH * z);
+
+    float innerX = kUnitBowlX + kUnitBowlThickness;
+    float innerY = kUnitBowlY + kUnitBowlThickness;
+    float innerW = kUnitBowlW - 2.0f * kUnitBowlThickness;
+    float innerH = kUnitBowlH - 2.0f * kUnitBowlThickness;
+    if (state.waterLevel > 0.0f)
+    {
+        float waterH = innerH * state.waterLevel;
+        pushRect(SLOT_WATER, x + innerX * z, y + (innerY + innerH - waterH) * z, innerW * z, waterH * z);
+    }
+    pushRect(SLOT_BOWL, x + kUnitBowlX * z, y + kUnitBowlY * z, kUnitBowlW * z, kUnitBowlThickness * z);
+    pushRect(SLOT_BOWL, x + kUnitBowlX * z, y + (kUnitBowlY + kUnitBowlH - kUnitBowlThickness) * z, kUnitBowlW * z, kUnitBowlThickness * z);
+    pushRect(SLOT_BOWL, x + kUnitBowlX * z, y + kUnitBowlY * z, kUnitBowlThickness * z, kUnitBowlH * z);
+    pushRect(SLOT_BOWL, x + (kUnitBowlX + kUnitBowlW - kUnitBowlThickness) * z, y + kUnitBowlY * z, kUnitBowlThickness * z, kUnitBowlH * z);
+}
+
+void Dashboard::drawFull(Renderer2D& renderer, TextRenderer& textRenderer, const AppState& state, float x, float y, RenderQueue* queue) const
+{
+    const float z = m_zoom;
+    renderer.drawRect(x, y, kUnitBodyW * z, kUnitBodyH * z, kUnitBodyColor);
+
+    float ventH = kUnitVentClosedH + (kUnitVentOpenH - kUnitVentClosedH) * state.ventOpenness;
+    renderer.drawRect(x + kUnitVentX * z, y + kUnitVentY * z, kUnitVentW * z, ventH * z, kUnitVentColor);
+    renderer.drawCircle(x + kUnitLampX * z, y + kUnitLampY * z, kUnitLampR * z, state.isOn ? kUnitLampOnColor : kUnitLampOffColor);
+
+    RectShape screens[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        screens[i] = RectShape{ x + (kUnitScreenX + i * kUnitScreenStep) * z, y + kUnitScreenY * z, kUnitScreenW * z, kUnitScreenH * z, state.isOn ? kUnitScreenOnColor : kUnitScreenOffColor };
+        renderer.drawRect(screens[i].x, screens[i].y, screens[i].w, screens[i].h, screens[i].color);
+    }
+    if (state.isOn)
+    {
+        std::uint8_t shapeLayer = queue ? queue->layer() : 0;
+        if (queue) queue->setLayer(static_cast<std::uint8_t>(shapeLayer + 1));
+        drawTemperatureValue(textRenderer, state.desiredTemp, screens[0], kUnitDigitColor);
+        drawTemperatureValue(textRenderer, state.currentTemp, screens[1], kUnitDigitColor);
+        if (queue) queue->setLayer(shapeLayer);
+        drawStatusIcon(renderer, screens[2], state.desiredTemp, state.currentTemp);
+    }
+
+    RectShape bowl{ x + kUnitBowlX * z, y + kUnitBowlY * z, kUnitBowlW * z, kUnitBowlH * z, kUnitBowlColor };
+    float thickness = kUnitBowlThickness * z;
+    if (state.waterLevel > 0.0f)
+    {
+        float innerH = bowl.h - 2.0f * thickness;
+        float waterH = innerH * state.waterLevel;
+        renderer.drawRect(bowl.x + thickness, bowl.y + thickness + innerH - waterH, bowl.w - 2.0f * thickness, waterH, kUnitWaterColor);
+    }
+    renderer.drawFrame(bowl, thickness);
+
+    RectShape arrowTop{ x + kUnitArrowX * z, y + kUnitScreenY * z, kUnitArrowW * z, kUnitScreenH * 0.5f * z, kUnitArrowBg };
+    RectShape arrowBottom{ arrowTop.x, arrowTop.y + arrowTop.h, arrowTop.w, arrowTop.h, kUnitArrowBg };
+    drawHalfArrow(renderer, arrowTop, true, kUnitArrowColor, kUnitArrowBg);
+    drawHalfArrow(renderer, arrowBottom, false, kUnitArrowColor, kUnitArrowBg);
+}
+
+int Dashboard::draw(Renderer2D& renderer, TextRenderer& textRenderer, const std::vector<AppState>& units, RenderQueue* queue) const
+{
+    // Cull to the rows and columns whose cells intersect the viewport.
+    float cellW = kCellW * m_zoom;
+    float cellH = kCellH * m_zoom;
+    int firstColumn = std::max(0, static_cast<int>(std::floor(-m_panX / cellW)));
+    int lastColumn = std::min(m_columns - 1, static_cast<int>(std::floor((m_viewWidth - m_panX) / cellW)));
+    int firstRow = std::max(0, static_cast<int>(std::floor(-m_panY / cellH)));
+    int lastRow = std::min(m_rows - 1, static_cast<int>(std::floor((m_viewHeight - m_panY) / cellH)));
+
+    int count = std::min(m_unitCount, static_cast<int>(units.size()));
+    float bodyPx = kUnitBodyW * m_zoom;
+    bool full = bodyPx >= kFullLodMinPx;
+    bool quad = bodyPx < kQuadLodMaxPx;
+
+    for (auto& batch : m_batches)
+    {
+        batch.clear();
+    }
+
+    int drawn = 0;
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+            int unit = row * m_columns + column;
+            if (unit >= count) break;
+
+            float x = m_panX + column * cellW;
+            float y = m_panY + row * cellH;
+            if (full) drawFull(renderer, textRenderer, units[unit], x, y, queue);
+            else if (quad) batchQuad(units[unit], x, y);
+            else batchFlat(units[unit], x, y);
+            ++drawn;
+        }
+    }
+
+    static const Color slotColors[SLOT_COUNT] = {
+        kUnitBodyColor, kUnitVentColor, kUnitScreenOffColor, kUnitScreenOnColor,
+        kHeatColor, kCoolColor, kOkColor, kUnitLampOffColor, kUnitLampOnColor,
+        kUnitArrowBg, kUnitWaterColor, kUnitBowlColor,
+        kQuadOffColor, kUnitWaterColor, kHeatColor, kCoolColor, kOkColor
+    };
+    for (int slot = 0; slot < SLOT_COUNT; ++slot)
+    {
+        renderer.drawRects(m_batches[slot], slotColors[slot]);
+    }
+
+    if (m_selected >= 0 && m_selected < count)
+    {
+        int column = m_selected % m_columns;
+        int row = m_selected / m_columns;
+        float pad = 6.0f;
+        RectShape outline{ m_panX + column * cellW - pad, m_panY + row * cellH - pad, bodyPx + 2.0f * pad, kUnitBodyH * m_zoom + 2.0f * pad, kSelectionColor };
+        if (outline.x < m_viewWidth && outline.y < m_viewHeight && outline.x + outline.w > 0.0f && outline.y + outline.h > 0.0f)
+        {
+            renderer.drawFrame(outline, 2.0f);
+        }
+    }
+
+    return drawn;
+}
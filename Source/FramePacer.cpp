@@ -0,0 +1,193 @@
+#include "../Header/FramePacer.h"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+namespace
+{
+    // Never plan to sleep closer to the deadline than this, however good the estimate gets.
+    constexpr double kMinSpinSeconds = 0.0002;
+    constexpr double kMaxOvershootEstimate = 0.004;
+
+    // Windows wakes sleeps and glfwWaitEventsTimeout on its 15.6 ms scheduler tick
+    // by default, far coarser than the overshoot the pacer budgets for. The finer
+    // tick costs power system-wide, so it is held only while the pacer waits.
+    class ScopedTimerResolution
+    {
+    public:
+        ScopedTimerResolution()
+        {
+#ifdef _WIN32
+            m_set = timeBeginPeriod(1) == TIMERR_NOERROR;
+#endif
+        }
+
+        ~ScopedTimerResolution()
+        {
+#ifdef _WIN32
+            if (m_set) timeEndPeriod(1);
+#endif
+        }
+
+        ScopedTimerResolution(const ScopedTimerResolution&) = delete;
+        ScopedTimerResolution& operator=(const ScopedTimerResolution&) = delete;
+
+    private:
+        bool m_set = false;
+    };
+}
+
+bool parseVsyncMode(const std::string& text, VsyncMode& out)
+{
+    if (text == "off") out = VsyncMode::Off;
+    else if (text == "on") out = VsyncMode::On;
+    else if (text == "adaptive") out = VsyncMode::Adaptive;
+    else return false;
+    return true;
+}
+
+int applyVsync(VsyncMode mode)
+{
+    int interval = 0;
+    if (mode == VsyncMode::On)
+    {
+        interval = 1;
+    }
+    else if (mode == VsyncMode::Adaptive)
+    {
+        bool tearControl = glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear");
+        interval = tearControl ? -1 : 1;
+    }
+    glfwSwapInterval(interval);
+    return interval;
+}
+
+FramePacer::FramePacer(double targetFps)
+{
+    setTargetFps(targetFps);
+}
+
+void FramePacer::setTargetFps(double fps)
+{
+    m_targetFps = fps > 0.0 ? fps : 0.0;
+    m_period = m_targetFps > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_targetFps))
+        : Clock::duration::zero();
+    m_deadline = Clock::now() + m_period;
+}
+
+void FramePacer::beginFrame()
+{
+    Clock::time_point now = Clock::now();
+    if (m_started)
+    {
+        double frame = std::chrono::duration<double>(now - m_lastFrameStart).count();
+        double ms = frame * 1000.0;
+        m_min = m_frames == 0 ? ms : std::min(m_min, ms);
+        m_max = m_frames == 0 ? ms : std::max(m_max, ms);
+        m_sum += ms;
+        m_sumSq += ms * ms;
+        m_windowSeconds += frame;
+        ++m_frames;
+    }
+    else
+    {
+        m_deadline = now + m_period;
+        m_started = true;
+    }
+    m_lastFrameStart = now;
+}
+
+double FramePacer::sleepBudgetSeconds() const
+{
+    if (m_period == Clock::duration::zero()) return 0.0;
+
+    double remaining = std::chrono::duration<double>(m_deadline - Clock::now()).count();
+    return remaining - std::max(m_overshootEstimate, kMinSpinSeconds);
+}
+
+void FramePacer::calibratedSleep(double seconds, const std::function<void(double seconds)>& sleep)
+{
+    Clock::time_point before = Clock::now();
+    sleep(seconds);
+    double actual = std::chrono::duration<double>(Clock::now() - before).count();
+
+    // Jump up quickly on a late wakeup, decay slowly when the OS behaves.
+    double overshoot = std::max(actual - seconds, 0.0);
+    if (overshoot > m_overshootEstimate)
+    {
+        m_overshootEstimate = std::min(overshoot, kMaxOvershootEstimate);
+    }
+    else
+    {
+        m_overshootEstimate += (overshoot - m_overshootEstimate) * 0.05;
+    }
+}
+
+void FramePacer::spinUntilDeadline()
+{
+    while (Clock::now() < m_deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::waitForNextFrame()
+{
+    waitForNextFrame([](double seconds)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    });
+}
+
+void FramePacer::waitForNextFrame(const std::function<void(double seconds)>& sleep)
+{
+    if (m_period == Clock::duration::zero()) return;
+
+    ScopedTimerResolution timerResolution;
+    double budget;
+    while ((budget = sleepBudgetSeconds()) > 0.0)
+    {
+        calibratedSleep(budget, sleep);
+    }
+    spinUntilDeadline();
+
+    // Advance by whole periods; if we fell more than a frame behind, resync instead of bursting.
+    m_deadline += m_period;
+    Clock::time_point now = Clock::now();
+    if (m_deadline < now)
+    {
+        m_deadline = now + m_period;
+    }
+}
+
+bool FramePacer::takeStats(FrameTimeStats& out, double intervalSeconds)
+{
+    if (m_frames == 0 || m_windowSeconds < intervalSeconds) return false;
+
+    double n = static_cast<double>(m_frames);
+    double mean = m_sum / n;
+    double variance = std::max(m_sumSq / n - mean * mean, 0.0);
+
+    out.frames = m_frames;
+    out.meanMs = mean;
+    out.stdDevMs = std::sqrt(variance);
+    out.minMs = m_min;
+    out.maxMs = m_max;
+
+    m_frames = 0;
+    m_sum = 0.0;
+    m_sumSq = 0.0;
+    m_windowSeconds = 0.0;
+    return true;
+}
@@ -0,0 +1,173 @@
+#include "../Header/GlState.h"
+
+#include <cstring>
+
+namespace
+{
+    std::uint32_t floatBits(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+constexpr GLuint GlState::kUnknown;
+
+GlState& glState()
+{
+    static GlState state;
+    return state;
+}
+
+GlState::GlState()
+{
+    m_textures.fill(kUnknown);
+}
+
+bool GlState::setIfChanged(GLuint& current, GLuint value)
+{
+    if (current == value)
+    {
+        ++m_counters.elided;
+        return false;
+    }
+    current = value;
+    ++m_counters.issued;
+    return true;
+}
+
+void GlState::useProgram(GLuint program)
+{
+    if (setIfChanged(m_program, program))
+    {
+        glUseProgram(program);
+        m_currentUniforms = &m_uniforms[program];
+    }
+    else if (!m_currentUniforms)
+    {
+        m_currentUniforms = &m_uniforms[program];
+    }
+}
+
+void GlState::bindVertexArray(GLuint vertexArray)
+{
+    if (setIfChanged(m_vertexArray, vertexArray))
+    {
+        glBindVertexArray(vertexArray);
+    }
+}
+
+void GlState::bindArrayBuffer(GLuint buffer)
+{
+    if (setIfChanged(m_arrayBuffer, buffer))
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    }
+}
+
+void GlState::activeTexture(GLenum unit)
+{
+    if (setIfChanged(m_activeUnit, unit))
+    {
+        glActiveTexture(unit);
+    }
+}
+
+void GlState::bindTexture2D(GLuint texture)
+{
+    int unit = m_activeUnit == kUnknown ? -1 : static_cast<int>(m_activeUnit - GL_TEXTURE0);
+    if (unit < 0 || unit >= kTextureUnits)
+    {
+        // Unit not tracked: bind without shadowing.
+        ++m_counters.issued;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        return;
+    }
+    if (setIfChanged(m_textures[unit], texture))
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+}
+
+bool GlState::uniformChanged(GLint location, const std::array<std::uint32_t, 4>& bits)
+{
+    if (!m_currentUniforms)
+    {
+        ++m_counters.issued;
+        return true;
+    }
+
+    std::vector<UniformValue>& values = *m_currentUniforms;
+    if (location >= static_cast<GLint>(values.size()))
+    {
+        values.resize(static_cast<size_t>(location) + 1);
+    }
+
+    UniformValue& value = values[location];
+    if (value.known && value.bits == bits)
+    {
+        ++m_counters.elided;
+        return false;
+    }
+    value.known = true;
+    value.bits = bits;
+    ++m_counters.issued;
+    return true;
+}
+
+void GlState::uniform1i(GLint location, GLint value)
+{
+    if (location < 0) return;
+    if (uniformChanged(location, { static_cast<std::uint32_t>(value), 0, 0, 0 }))
+    {
+        glUniform1i(location, value);
+    }
+}
+
+void GlState::uniform2f(GLint location, float x, float y)
+{
+    if (location < 0) return;
+    if (uniformChanged(location, { floatBits(x), floatBits(y), 0, 0 }))
+    {
+        glUniform2f(location, x, y);
+    }
+}
+
+void GlState::uniform4f(GLint location, float x, float y, float z, float w)
+{
+    if (location < 0) return;
+    if (uniformChanged(location, { floatBits(x), floatBits(y), floatBits(z), floatBits(w) }))
+    {
+        glUniform4f(location, x, y, z, w);
+    }
+}
+
+void GlState::forgetProgram(GLuint program)
+{
+    // GL may hand the same name to the next program, so its uniform values must go.
+    auto it = m_uniforms.find(program);
+    if (it != m_uniforms.end())
+    {
+        if (m_currentUniforms == &it->second) m_currentUniforms = nullptr;
+        m_uniforms.erase(it);
+    }
+    if (m_program == program) m_program = kUnknown;
+}
+
+void GlState::forgetTexture(GLuint texture)
+{
+    for (GLuint& bound : m_textures)
+    {
+        if (bound == texture) bound = kUnknown;
+    }
+}
+
+void GlState::invalidate()
+{
+    m_program = kUnknown;
+    m_vertexArray = kUnknown;
+    m_arrayBuffer = kUnknown;
+    m_activeUnit = kUnknown;
+    m_textures.fill(kUnknown);
+}
@@ -0,0 +1,98 @@
+#include "../Header/GpuTimer.h"
+
+#include <algorithm>
+
+namespace
+{
+    const char* kPassNames[] = { "clear", "body", "screens", "status", "bowl", "graph", "overlay" };
+}
+
+const char* gpuPassName(GpuPass pass)
+{
+    return kPassNames[static_cast<int>(pass)];
+}
+
+GpuTimer::GpuTimer()
+    : m_windowStart(std::chrono::steady_clock::now())
+{
+    for (FrameQueries& frame : m_frames)
+    {
+        glGenQueries(kPassCount, frame.queries.data());
+    }
+}
+
+GpuTimer::~GpuTimer()
+{
+    for (FrameQueries& frame : m_frames)
+    {
+        glDeleteQueries(kPassCount, frame.queries.data());
+    }
+}
+
+void GpuTimer::beginFrame()
+{
+    if (m_activePass >= 0) end();
+
+    // Reuse the oldest set, harvesting whatever it measured kFramesInFlight frames ago.
+    m_current = (m_current + 1) % kFramesInFlight;
+    collect(m_frames[m_current]);
+}
+
+void GpuTimer::begin(GpuPass pass)
+{
+    if (m_activePass >= 0) end();
+
+    int index = static_cast<int>(pass);
+    FrameQueries& frame = m_frames[m_current];
+    if (frame.pending[index]) return; // pass already timed this frame
+
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[index]);
+    m_activePass = index;
+}
+
+void GpuTimer::end()
+{
+    if (m_activePass < 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_frames[m_current].pending[m_activePass] = true;
+    m_activePass = -1;
+}
+
+void GpuTimer::collect(FrameQueries& frame)
+{
+    for (int i = 0; i < kPassCount; ++i)
+    {
+        if (!frame.pending[i]) continue;
+        frame.pending[i] = false;
+
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsedNs);
+        double ms = static_cast<double>(elapsedNs) / 1e6;
+        m_sumMs[i] += ms;
+        m_maxMs[i] = std::max(m_maxMs[i], ms);
+        ++m_samples[i];
+    }
+}
+
+bool GpuTimer::takeReport(GpuReport& out, double intervalSeconds)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - m_windowStart).count() < intervalSeconds) return false;
+    m_windowStart = now;
+
+    for (int i = 0; i < kPassCount; ++i)
+    {
+        GpuPassStats& stats = out[i];
+        stats.samples = m_samples[i];
+        stats.meanMs = m_samples[i] > 0 ? m_sumMs[i] / m_samples[i] : 0.0;
+        stats.maxMs = m_maxMs[i];
+        m_sumMs[i] = 0.0;
+        m_maxMs[i] = 0.0;
+        m_samples[i] = 0;
+    }
+    return true;
+}
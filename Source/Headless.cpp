@@ -0,0 +1,87 @@
+#include "../Header/Headless.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+bool parseHeadlessBackend(const std::string& text, HeadlessBackend& out)
+{
+    if (text == "egl") out = HeadlessBackend::Egl;
+    else if (text == "osmesa") out = HeadlessBackend::OsMesa;
+    else return false;
+    return true;
+}
+
+bool parseFrameSize(const std::string& text, int& width, int& height)
+{
+    int w = 0;
+    int h = 0;
+    if (std::sscanf(text.c_str(), "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0) return false;
+    width = w;
+    height = h;
+    return true;
+}
+
+void configureHeadlessPlatform(HeadlessBackend backend)
+{
+    if (backend == HeadlessBackend::None) return;
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+}
+
+void applyHeadlessWindowHints(HeadlessBackend backend)
+{
+    if (backend == HeadlessBackend::None) return;
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, backend == HeadlessBackend::OsMesa ? GLFW_OSMESA_CONTEXT_API : GLFW_EGL_CONTEXT_API);
+}
+
+OffscreenTarget::OffscreenTarget(int width, int height)
+    : m_width(width)
+    , m_height(height)
+{
+    glGenFramebuffers(1, &m_framebuffer);
+    glGenRenderbuffers(1, &m_colorBuffer);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    m_complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+OffscreenTarget::~OffscreenTarget()
+{
+    if (m_colorBuffer != 0) glDeleteRenderbuffers(1, &m_colorBuffer);
+    if (m_framebuffer != 0) glDeleteFramebuffers(1, &m_framebuffer);
+}
+
+void OffscreenTarget::bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+}
+
+bool OffscreenTarget::writePpm(const std::string& path) const
+{
+    std::vector<unsigned char> pixels(static_cast<size_t>(m_width) * m_height * 3);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out << "P6\n" << m_width << " " << m_height << "\n255\n";
+
+    // GL rows start at the bottom.
+    size_t rowBytes = static_cast<size_t>(m_width) * 3;
+    for (int y = m_height - 1; y >= 0; --y)
+    {
+        out.write(reinterpret_cast<const char*>(&pixels[y * rowBytes]), static_cast<std::streamsize>(rowBytes));
+    }
+    return static_cast<bool>(out);
+}
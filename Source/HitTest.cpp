@@ -0,0 +1,137 @@
+#include "../Header/HitTest.h"
+
+#include "../Header/Controls.h"
+
+#include <algorithm>
+#include <cmath>
+
+HitTestGrid::HitTestGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 64.0f)
+{
+}
+
+void HitTestGrid::setRect(int id, const RectShape& rect, int z)
+{
+    Control updated;
+    updated.kind = Kind::Rect;
+    updated.rect = rect;
+    updated.z = z;
+    place(id, updated, rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
+}
+
+void HitTestGrid::setCircle(int id, const CircleShape& circle, int z)
+{
+    Control updated;
+    updated.kind = Kind::Circle;
+    updated.circle = circle;
+    updated.z = z;
+    place(id, updated, circle.x - circle.radius, circle.y - circle.radius, circle.x + circle.radius, circle.y + circle.radius);
+}
+
+void HitTestGrid::remove(int id)
+{
+    if (id < 0 || id >= static_cast<int>(m_controls.size()) || !m_controls[id].active) return;
+    unlink(id, m_controls[id]);
+    m_controls[id].active = false;
+}
+
+void HitTestGrid::clear()
+{
+    m_controls.clear();
+    m_cells.clear();
+}
+
+int HitTestGrid::hitTest(double x, double y) const
+{
+    auto it = m_cells.find(cellKey(cellCoord(x), cellCoord(y)));
+    if (it == m_cells.end()) return -1;
+
+    for (int id : it->second)
+    {
+        if (contains(m_controls[id], x, y)) return id;
+    }
+    return -1;
+}
+
+void HitTestGrid::place(int id, const Control& updated, float minX, float minY, float maxX, float maxY)
+{
+    if (id < 0) return;
+    if (id >= static_cast<int>(m_controls.size()))
+    {
+        m_controls.resize(id + 1);
+    }
+
+    Control next = updated;
+    next.active = true;
+    next.minCellX = cellCoord(minX);
+    next.minCellY = cellCoord(minY);
+    next.maxCellX = cellCoord(maxX);
+    next.maxCellY = cellCoord(maxY);
+
+    Control& current = m_controls[id];
+    bool sameCells = current.active && current.z == next.z
+        && current.minCellX == next.minCellX && current.minCellY == next.minCellY
+        && current.maxCellX == next.maxCellX && current.maxCellY == next.maxCellY;
+    if (sameCells)
+    {
+        // Moved or resized inside the same cells: the cell lists are still right.
+        current = next;
+        return;
+    }
+
+    if (current.active)
+    {
+        unlink(id, current);
+    }
+    current = next;
+    link(id, current);
+}
+
+void HitTestGrid::unlink(int id, const Control& control)
+{
+    for (int cy = control.minCellY; cy <= control.maxCellY; ++cy)
+    {
+        for (int cx = control.minCellX; cx <= control.maxCellX; ++cx)
+        {
+            auto it = m_cells.find(cellKey(cx, cy));
+            if (it == m_cells.end()) continue;
+            std::vector<int>& ids = it->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            if (ids.empty()) m_cells.erase(it);
+        }
+    }
+}
+
+void HitTestGrid::link(int id, const Control& control)
+{
+    for (int cy = control.minCellY; cy <= control.maxCellY; ++cy)
+    {
+        for (int cx = control.minCellX; cx <= control.maxCellX; ++cx)
+        {
+            std::vector<int>& ids = m_cells[cellKey(cx, cy)];
+            auto pos = std::lower_bound(ids.begin(), ids.end(), id, [this](int a, int b) { return ranksAbove(a, b); });
+            ids.insert(pos, id);
+        }
+    }
+}
+
+bool HitTestGrid::ranksAbove(int a, int b) const
+{
+    if (m_controls[a].z != m_controls[b].z) return m_controls[a].z > m_controls[b].z;
+    return a > b;
+}
+
+bool HitTestGrid::contains(const Control& control, double x, double y) const
+{
+    return control.kind == Kind::Rect ? pointInRect(x, y, control.rect) : pointInCircle(x, y, control.circle);
+}
+
+int HitTestGrid::cellCoord(double v) const
+{
+    return static_cast<int>(std::floor(v / m_cellSize));
+}
+
+std::uint64_t HitTestGrid::cellKey(int cx, int cy)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+}
@@ -0,0 +1,48 @@
+#include "../Header/Input.h"
+
+void InputSystem::drain(std::vector<InputEvent>& out)
+{
+    out.clear();
+    out.swap(m_events);
+}
+
+void InputSystem::onKey(int key, int action)
+{
+    InputEvent event;
+    event.type = InputEventType::Key;
+    event.code = key;
+    event.action = action;
+    event.timestamp = std::chrono::steady_clock::now();
+    m_events.push_back(event);
+}
+
+void InputSystem::onMouseButton(GLFWwindow* window, int button, int action)
+{
+    InputEvent event;
+    event.type = InputEventType::MouseButton;
+    event.code = button;
+    event.action = action;
+    glfwGetCursorPos(window, &event.x, &event.y);
+    event.timestamp = std::chrono::steady_clock::now();
+    m_events.push_back(event);
+}
+
+void InputSystem::onScroll(GLFWwindow* window, double yOffset)
+{
+    InputEvent event;
+    event.type = InputEventType::Scroll;
+    event.scroll = yOffset;
+    glfwGetCursorPos(window, &event.x, &event.y);
+    event.timestamp = std::chrono::steady_clock::now();
+    m_events.push_back(event);
+}
+
+void InputSystem::onCursorMove(double x, double y)
+{
+    InputEvent event;
+    event.type = InputEventType::CursorMove;
+    event.x = x;
+    event.y = y;
+    event.timestamp = std::chrono::steady_clock::now();
+    m_events.push_back(event);
+}
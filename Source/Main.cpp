@@ -7,69 +7,294 @@
 #include "../Header/TemperatureUI.h"
 #include "../Header/Controls.h"
 #include "../Header/TextRenderer.h"
+#include "../Header/Controller.h"
+#include "../Header/Telemetry.h"
+#include "../Header/TelemetryLog.h"
+#include "../Header/TemperatureGraph.h"
+#include "../Header/FramePacer.h"
+#include "../Header/RenderDamage.h"
+#include "../Header/RenderQueue.h"
+#include "../Header/Simulation.h"
+#include "../Header/Input.h"
+#include "../Header/SceneLayout.h"
+#include "../Header/Dashboard.h"
+#include "../Header/Profiler.h"
+#include "../Header/GpuTimer.h"
+#include "../Header/GlState.h"
+#include "../Header/Trace.h"
+#include "../Header/Headless.h"
+#include "../Header/Benchmark.h"
+#include "../Header/ShaderCache.h"
+#include "../Header/ShaderManager.h"
+#include "../Header/ShaderSources.h"
+#include "../Header/ShaderWatcher.h"
+#include "../Header/TextureLoader.h"
 
 #include <array>
+#include <chrono>
 #include <algorithm>
 #include <cmath>
-#include <chrono>
 #include <string>
 #include <cstdio>
-#include <thread>
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
 
 // Entry point: fullscreen AC simulator with timed logic and on-screen UI.
 const double TARGET_FPS = 75.0;
-const double TARGET_FRAME_TIME = 1.0 / TARGET_FPS;
-
-// Pointers handed to the framebuffer-size callback so we can update renderers on resize.
+const double POWER_SAVE_IDLE_WAIT = 0.5; // max seconds between wakeups when nothing is animating
+const double DASHBOARD_SIM_HZ = 120.0; // default tick rate with many units
+const double POWER_SAVE_SIM_HZ = 60.0; // default tick rate with --power-save
+const float DASHBOARD_PAN_STEP = 60.0f; // pixels per WASD press
+const float DASHBOARD_ZOOM_STEP = 1.15f; // per wheel notch or +/- press
+const double HEADLESS_FRAME_HZ = 60.0; // simulated time per headless frame is 1 / this
+const double TEXTURE_UPLOAD_BUDGET = 0.002; // seconds of texture uploads per frame
+
+// Pointers handed to the GLFW window callbacks (resize, refresh, key, mouse button).
 struct ResizeContext
 {
     Renderer2D* renderer = nullptr;
     TextRenderer* textRenderer = nullptr;
     int* windowWidth = nullptr;
     int* windowHeight = nullptr;
+    RenderDamage* damage = nullptr;
+    InputSystem* input = nullptr;
+    Dashboard* dashboard = nullptr;
+    SceneLayout* layout = nullptr;
 };
 
-int main()
+int main(int argc, char** argv)
 {
-    glfwInit();
+    std::string controllerName = "bangbang";
+    std::string recordPath;
+    std::string tracePath;
+    double targetFps = TARGET_FPS;
+    bool fpsGiven = false;
+    VsyncMode vsyncMode = VsyncMode::Off;
+    bool powerSave = false;
+    double simHz = 1000.0;
+    bool simHzGiven = false;
+    int dashboardUnits = 0;
+    HeadlessBackend headless = HeadlessBackend::None;
+    int headlessFrames = 300;
+    int headlessWidth = 1280;
+    int headlessHeight = 720;
+    std::string dumpDir;
+    bool benchRender = false;
+    RenderBenchOptions benchOptions;
+    bool benchSim = false;
+    SimBenchOptions simBenchOptions;
+    bool shaderReload = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--controller" && i + 1 < argc)
+        {
+            controllerName = argv[++i];
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--sim-hz" && i + 1 < argc)
+        {
+            simHz = std::atof(argv[++i]);
+            simHzGiven = true;
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (arg == "--dashboard" && i + 1 < argc)
+        {
+            dashboardUnits = std::max(std::atoi(argv[++i]), 0);
+        }
+        else if (arg == "--headless" && i + 1 < argc)
+        {
+            if (!parseHeadlessBackend(argv[++i], headless))
+            {
+                std::cout << "Unknown headless backend \"" << argv[i] << "\", using egl.\n";
+                headless = HeadlessBackend::Egl;
+            }
+        }
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            headlessFrames = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if (arg == "--size" && i + 1 < argc)
+        {
+            if (!parseFrameSize(argv[++i], headlessWidth, headlessHeight))
+            {
+                std::cout << "Bad size \"" << argv[i] << "\", expected WIDTHxHEIGHT.\n";
+            }
+        }
+        else if (arg == "--dump-dir" && i + 1 < argc)
+        {
+            dumpDir = argv[++i];
+        }
+        else if (arg == "--bench-render")
+        {
+            benchRender = true;
+        }
+        else if (arg == "--bench-max" && i + 1 < argc)
+        {
+            benchOptions.maxPrimitives = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if (arg == "--bench-sim")
+        {
+            benchSim = true;
+        }
+        else if (arg == "--bench-json" && i + 1 < argc)
+        {
+            simBenchOptions.jsonPath = argv[++i];
+        }
+        else if (arg == "--bench-baseline" && i + 1 < argc)
+        {
+            simBenchOptions.baselinePath = argv[++i];
+        }
+        else if (arg == "--max-regression" && i + 1 < argc)
+        {
+            simBenchOptions.maxRegressionPercent = std::atof(argv[++i]);
+        }
+        else if (arg == "--no-shader-cache")
+        {
+            setShaderCacheDirectory("");
+        }
+        else if (arg == "--shader-dir" && i + 1 < argc)
+        {
+            setShaderOverrideDirectory(argv[++i]);
+        }
+        else if (arg == "--shader-reload")
+        {
+            shaderReload = true;
+        }
+        else if (arg == "--power-save")
+        {
+            powerSave = true;
+        }
+        else if (arg == "--fps" && i + 1 < argc)
+        {
+            targetFps = std::atof(argv[++i]);
+            fpsGiven = true;
+        }
+        else if (arg == "--vsync" && i + 1 < argc)
+        {
+            if (!parseVsyncMode(argv[++i], vsyncMode))
+            {
+                std::cout << "Unknown vsync mode \"" << argv[i] << "\", using off.\n";
+                vsyncMode = VsyncMode::Off;
+            }
+        }
+    }
+
+    // The simulation benchmark needs no window or GL context.
+    if (benchSim) return runSimulationBenchmarks(simBenchOptions);
+
+    std::unique_ptr<ThermostatController> controller = createController(controllerName);
+    if (!controller)
+    {
+        std::cout << "Unknown controller \"" << controllerName << "\", using bangbang.\n";
+        controllerName = "bangbang";
+        controller = createController(controllerName);
+    }
+    if (dashboardUnits > 0 && !simHzGiven)
+    {
+        simHz = DASHBOARD_SIM_HZ;
+    }
+
+    // Headless: no display, a fixed frame count rendered into an FBO as fast as
+    // possible, with the simulation stepped a fixed amount per frame.
+    bool isHeadless = headless != HeadlessBackend::None;
+    if (isHeadless)
+    {
+        powerSave = false;
+    }
+    if (powerSave && !simHzGiven)
+    {
+        simHz = std::min(simHz, POWER_SAVE_SIM_HZ);
+    }
+
+    configureHeadlessPlatform(headless);
+    if (!glfwInit()) return endProgram("GLFW nije uspeo da se inicijalizuje.");
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    applyHeadlessWindowHints(headless);
 
-    GLFWmonitor* primary = glfwGetPrimaryMonitor();
-    const GLFWvidmode* mode = glfwGetVideoMode(primary); // fullscreen mode descriptor
+    GLFWmonitor* primary = isHeadless ? NULL : glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = primary ? glfwGetVideoMode(primary) : NULL; // fullscreen mode descriptor
 
-    int windowWidth = mode ? mode->width : 800;
-    int windowHeight = mode ? mode->height : 800;
+    int windowWidth = isHeadless ? headlessWidth : mode ? mode->width : 800;
+    int windowHeight = isHeadless ? headlessHeight : mode ? mode->height : 800;
     GLFWwindow* window = glfwCreateWindow(windowWidth, windowHeight, "AC Simulator", primary, NULL);
     if (window == NULL) return endProgram("Prozor nije uspeo da se kreira.");
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(0);
+    if (!isHeadless)
+    {
+        applyVsync(vsyncMode);
+    }
 
     if (glewInit() != GLEW_OK) return endProgram("GLEW nije uspeo da se inicijalizuje.");
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    int fbWidth = 0, fbHeight = 0;
-    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    int fbWidth = windowWidth, fbHeight = windowHeight;
+    std::unique_ptr<OffscreenTarget> offscreen;
+    if (isHeadless)
+    {
+        offscreen.reset(new OffscreenTarget(fbWidth, fbHeight));
+        if (!offscreen->isComplete()) return endProgram("Offscreen framebuffer nije kompletan.");
+        offscreen->bind();
+    }
+    else
+    {
+        glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    }
     glViewport(0, 0, fbWidth, fbHeight);
 
     const Color backgroundColor{ 0.10f, 0.12f, 0.16f, 1.0f };
     glClearColor(backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
 
-    // Shader program and basic geometry
+    // Development: edits to the watched shader files are rebuilt in the background
+    // and swapped in between frames.
+    std::unique_ptr<ShaderWatcher> shaderWatcher;
+    std::vector<std::string> changedShaders;
+    if (shaderReload)
+    {
+        if (shaderOverrideDirectory().empty()) setShaderOverrideDirectory("Shaders");
+        shaderWatcher.reset(new ShaderWatcher(shaderOverrideDirectory()));
+    }
+
+    // Shader programs are only submitted here; the driver compiles them while the
+    // font loads and the scene is set up, and each is first waited on when drawn.
+    shaderManager().init();
+    ShaderManager::Handle overlayShader = shaderManager().submit("Shaders/overlay.vert", "Shaders/overlay.frag");
     Renderer2D renderer(fbWidth, fbHeight, "Shaders/basic.vert", "Shaders/basic.frag");
     TextRenderer textRenderer(fbWidth, fbHeight);
-    GLuint overlayProgram = createShader("Shaders/overlay.vert", "Shaders/overlay.frag");
-    GLint overlayWindowSizeLoc = glGetUniformLocation(overlayProgram, "uWindowSize");
-    GLint overlayTintLoc = glGetUniformLocation(overlayProgram, "uTint");
-    GLint overlayTextureLoc = glGetUniformLocation(overlayProgram, "uTexture");
+    unsigned int overlayShaderVersion = ~0u;
+    GLint overlayWindowSizeLoc = -1;
+    GLint overlayTintLoc = -1;
+    GLint overlayTextureLoc = -1;
 
+    if (benchRender)
+    {
+        runRenderBenchmarks(renderer, textRenderer, fbWidth, fbHeight, benchOptions);
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 0;
+    }
+
+    RenderDamage damage;
+    InputSystem input;
     ResizeContext resizeCtx;
     resizeCtx.renderer = &renderer;
     resizeCtx.textRenderer = &textRenderer;
     resizeCtx.windowWidth = &windowWidth;
     resizeCtx.windowHeight = &windowHeight;
+    resizeCtx.damage = &damage;
+    resizeCtx.input = &input;
     glfwSetWindowUserPointer(window, &resizeCtx);
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow* win, int w, int h)
     {
@@ -80,59 +305,48 @@ int main()
         if (ctx->windowHeight) *ctx->windowHeight = h;
         if (ctx->renderer) ctx->renderer->setWindowSize(static_cast<float>(w), static_cast<float>(h));
         if (ctx->textRenderer) ctx->textRenderer->setWindowSize(static_cast<float>(w), static_cast<float>(h));
+        if (ctx->dashboard) ctx->dashboard->setViewportSize(static_cast<float>(w), static_cast<float>(h));
+        if (ctx->layout) ctx->layout->resize(w, h);
+        if (ctx->damage) ctx->damage->markDirty();
+    });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* win)
+    {
+        auto* ctx = static_cast<ResizeContext*>(glfwGetWindowUserPointer(win));
+        if (ctx && ctx->damage) ctx->damage->markDirty();
+    });
+    glfwSetKeyCallback(window, [](GLFWwindow* win, int key, int, int action, int)
+    {
+        auto* ctx = static_cast<ResizeContext*>(glfwGetWindowUserPointer(win));
+        if (ctx && ctx->input) ctx->input->onKey(key, action);
+    });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* win, int button, int action, int)
+    {
+        auto* ctx = static_cast<ResizeContext*>(glfwGetWindowUserPointer(win));
+        if (ctx && ctx->input) ctx->input->onMouseButton(win, button, action);
+    });
+    glfwSetScrollCallback(window, [](GLFWwindow* win, double, double yOffset)
+    {
+        auto* ctx = static_cast<ResizeContext*>(glfwGetWindowUserPointer(win));
+        if (ctx && ctx->input) ctx->input->onScroll(win, yOffset);
+    });
+    glfwSetCursorPosCallback(window, [](GLFWwindow* win, double x, double y)
+    {
+        auto* ctx = static_cast<ResizeContext*>(glfwGetWindowUserPointer(win));
+        if (ctx && ctx->input) ctx->input->onCursorMove(x, y);
     });
 
-    const Color bodyColor{ 0.90f, 0.93f, 0.95f, 1.0f };
-    const Color ventColor{ 0.32f, 0.36f, 0.45f, 1.0f };
-    const Color lampOffColor{ 0.22f, 0.18f, 0.20f, 1.0f };
-    const Color lampOnColor{ 0.93f, 0.22f, 0.20f, 1.0f };
-    const Color screenOffColor{ 0.08f, 0.10f, 0.12f, 1.0f };
-    const Color screenOnColor{ 0.18f, 0.68f, 0.72f, 1.0f };
-    const Color bowlColor{ 0.78f, 0.82f, 0.88f, 1.0f };
-    const Color digitColor{ 0.96f, 0.98f, 1.0f, 1.0f };
-    const Color arrowBg{ 0.15f, 0.18f, 0.22f, 1.0f };
-    const Color arrowColor{ 0.90f, 0.96f, 1.0f, 1.0f };
-    const Color waterColor{ 0.50f, 0.78f, 0.94f, 0.9f };
     const Color nameplateBg{ 0.08f, 0.08f, 0.10f, 0.45f };
     const Color nameplateText{ 0.96f, 0.98f, 1.0f, 0.95f };
+    const Color graphBg{ 0.13f, 0.15f, 0.19f, 1.0f };
+    const Color graphCurrentColor{ 0.35f, 0.85f, 0.90f, 1.0f };
+    const Color graphDesiredColor{ 0.96f, 0.62f, 0.30f, 1.0f };
 
-    const float acWidth = 480.0f;
-    const float acHeight = 200.0f;
-    const float acY = 0.0f;
-
-    RectShape acBody{ 0.0f, acY, acWidth, acHeight, bodyColor };
-
-    const float ventClosedHeight = 4.0f;
-    const float ventOpenHeight = 18.0f;
-    RectShape ventBar{ 24.0f, acY + acHeight - 64.0f, acWidth - 48.0f, ventClosedHeight, ventColor };
-    CircleShape lamp{ acWidth - 44.0f, acY + acHeight - 26.0f, 14.0f, lampOffColor };
-
-    const float screenWidth = 94.0f;
-    const float screenHeight = 54.0f;
-    const float screenSpacing = 22.0f;
-    const float screenStartX = 70.0f;
-    const float screenY = acY + 52.0f;
-    std::array<RectShape, 3> screens{};
-    for (size_t i = 0; i < screens.size(); ++i)
-    {
-        screens[i] = RectShape{
-            screenStartX + static_cast<float>(i) * (screenWidth + screenSpacing),
-            screenY,
-            screenWidth,
-            screenHeight,
-            screenOffColor
-        };
-    }
-
-    const float arrowWidth = 40.0f;
-    RectShape tempArrowButton{ screenStartX - arrowWidth - 12.0f, screenY, arrowWidth, screenHeight, arrowBg };
-
-    const float bowlWidth = 260.0f;
-    const float bowlHeight = 140.0f;
-    const float bowlThickness = 10.0f;
-    const float bowlX = (acWidth - bowlWidth) * 0.5f;
-    const float bowlY = acY + acHeight + 120.0f;
-    RectShape bowlOutline{ bowlX, bowlY, bowlWidth, bowlHeight, bowlColor };
+    SceneShapes sceneShapes = makeUnitShapes();
+    // History graph to the right of the unit.
+    sceneShapes.graph = RectShape{ kUnitBodyW + 40.0f, 0.0f, 360.0f, kUnitBodyH, graphBg };
+    SceneLayout layout(sceneShapes);
+    layout.resize(fbWidth, fbHeight);
+    resizeCtx.layout = &layout;
 
     GLuint nameplateTexture = 0;
     int nameplateW = 0;
@@ -143,14 +357,13 @@ int main()
     GLuint overlayVbo = 0;
     glGenVertexArrays(1, &overlayVao);
     glGenBuffers(1, &overlayVbo);
-    glBindVertexArray(overlayVao);
-    glBindBuffer(GL_ARRAY_BUFFER, overlayVbo);
+    glState().bindVertexArray(overlayVao);
+    glState().bindArrayBuffer(overlayVbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 24, nullptr, GL_DYNAMIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glBindVertexArray(0);
 
     // Create and set a simple remote-shaped cursor (hotspot at laser dot top-left).
     auto setProceduralCursor = [&]()
@@ -163,152 +376,218 @@ int main()
         }
     };
 
-    setProceduralCursor();
-
-    AppState appState{};
-    std::string frameStats = "FPS --";
-    double logAccumulator = 0.0;
-    int logFrames = 0;
+    if (!isHeadless)
+    {
+        setProceduralCursor();
+    }
 
-    auto lastTime = std::chrono::steady_clock::now(); // main clock source
+    TelemetryRing telemetry; // per-tick history for graphs and exporters
 
-    while (!glfwWindowShouldClose(window))
+    // Optional compressed archive of the run, fed from the telemetry ring.
+    TelemetryLogWriter recorder;
+    TelemetryReader recorderReader(telemetry, true);
+    if (!recordPath.empty())
     {
-        auto frameStartTime = std::chrono::steady_clock::now();
-        float deltaTime = std::chrono::duration_cast<std::chrono::duration<float>>(frameStartTime - lastTime).count(); // seconds since last frame
-        lastTime = frameStartTime;
-        logAccumulator += deltaTime;
-        ++logFrames;
-        if (logAccumulator >= 1.0)
-        {
-            double avgDelta = logAccumulator / static_cast<double>(logFrames);
-            double avgFps = avgDelta > 0.0 ? 1.0 / avgDelta : 0.0;
-            char buf[64];
-            std::snprintf(buf, sizeof(buf), "FPS %.1f", avgFps); // once per second
-            frameStats = buf;
-            logAccumulator = 0.0;
-            logFrames = 0;
-        }
-
-        double mouseX, mouseY;
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-        bool mouseDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-        bool upPressed = glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS;
-        bool downPressed = glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS;
-        bool spacePressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        {
-            glfwSetWindowShouldClose(window, GLFW_TRUE);
-        }
-        bool clickStarted = mouseDown && !appState.prevMouseDown;
+        recorder.open(recordPath);
+    }
 
-        float sceneMinX = std::min({ acBody.x, tempArrowButton.x, bowlOutline.x });
-        float sceneMaxX = std::max({ acBody.x + acBody.w, tempArrowButton.x + tempArrowButton.w, bowlOutline.x + bowlOutline.w });
-        float sceneMinY = std::min({ acBody.y, tempArrowButton.y, bowlOutline.y });
-        float sceneMaxY = std::max({ acBody.y + acBody.h, tempArrowButton.y + tempArrowButton.h, bowlOutline.y + bowlOutline.h });
-        float sceneW = sceneMaxX - sceneMinX;
-        float sceneH = sceneMaxY - sceneMinY;
-        float offsetX = (static_cast<float>(windowWidth) - sceneW) * 0.5f - sceneMinX;
-        float offsetY = (static_cast<float>(windowHeight) - sceneH) * 0.5f - sceneMinY;
+    TemperatureGraph temperatureGraph(telemetry);
+    // Headless frames show fixed text instead: wall-clock stats would make dumped frames differ between runs.
+    std::string frameStats = isHeadless ? "headless" : "FPS --";
 
-        auto shiftRect = [&](const RectShape& r)
-        {
-            RectShape out = r;
-            out.x += offsetX;
-            out.y += offsetY;
-            return out;
-        };
-        auto shiftCircle = [&](const CircleShape& c)
-        {
-            CircleShape out = c;
-            out.x += offsetX;
-            out.y += offsetY;
-            return out;
-        };
+    // With vsync the swap already paces frames, so only limit when asked to.
+    FramePacer pacer(isHeadless ? 0.0 : vsyncMode == VsyncMode::Off || fpsGiven ? targetFps : 0.0);
 
-        RectShape acBodyDraw = shiftRect(acBody);
-        RectShape ventBarDraw = shiftRect(ventBar);
-        CircleShape lampDraw = shiftCircle(lamp);
+    // Dashboard mode: a grid of units, each with its own state and controller.
+    std::unique_ptr<Dashboard> dashboard;
+    std::vector<AppState> units(1);
+    std::vector<std::unique_ptr<ThermostatController>> controllers;
+    controllers.push_back(std::move(controller));
+    if (dashboardUnits > 0)
+    {
+        dashboard.reset(new Dashboard(dashboardUnits, static_cast<float>(fbWidth) / static_cast<float>(std::max(fbHeight, 1))));
+        dashboard->setViewportSize(static_cast<float>(fbWidth), static_cast<float>(fbHeight));
+        dashboard->fitAll();
+        resizeCtx.dashboard = dashboard.get();
 
-        std::array<RectShape, 3> screensDraw = screens;
-        for (auto& s : screensDraw)
+        units = makeDashboardUnits(dashboardUnits);
+        while (controllers.size() < units.size())
         {
-            s = shiftRect(s);
+            controllers.push_back(createController(controllerName));
         }
+    }
+    bool dragging = false;
+    double dragX = 0.0;
+    double dragY = 0.0;
+
+    // Per-phase CPU timings; F3 shows their percentiles.
+    FrameProfiler profiler;
+    ProfileReport profileReport;
+    GpuTimer gpuTimer; // GPU time per pass, shown next to the CPU phases
+
+    // Scenes are recorded with one queue layer per GPU pass (layer = GpuPass value),
+    // so the sorted replay still starts each pass's timer where its draws begin.
+    RenderQueue renderQueue;
+    auto passLayer = [](GpuPass pass) { return static_cast<std::uint8_t>(pass); };
+    const RenderQueue::LayerCallback beginPassForLayer = [&gpuTimer](std::uint8_t layer)
+    {
+        gpuTimer.begin(static_cast<GpuPass>(layer));
+    };
+    GpuReport gpuReport;
+    std::vector<std::string> profileLines;
+    GlCallCounters glCallsAtReport; // state-tracker totals at the previous report
+    int framesSinceReport = 0;
+    bool showProfiler = false;
+
+    // Simulation ticks on its own thread; this thread renders the newest snapshot.
+    SimulationThread simulation(telemetry, std::move(units), std::move(controllers), simHz);
+    simulation.setProfiler(&profiler);
+    simulation.setIdleWhenAtRest(powerSave);
+    int headlessTicksPerFrame = std::max(1, static_cast<int>(std::lround(simHz / HEADLESS_FRAME_HZ)));
+    int headlessFrame = 0;
+    if (!isHeadless)
+    {
+        simulation.start();
+    }
+
+    // Trace export (builds with AC_ENABLE_TRACING only): F9 writes a snapshot,
+    // and --trace also writes one on exit.
+    traceSetThreadName("render");
+    auto writeTrace = [&]()
+    {
+        std::string path = tracePath.empty() ? "trace.json" : tracePath;
+        if (traceWriteChromeJson(path)) std::cout << "Trace written to " << path << "\n";
+        else std::cout << "Tracing is not compiled in (define AC_ENABLE_TRACING) or " << path << " could not be written.\n";
+    };
 
-        RectShape tempArrowDraw = shiftRect(tempArrowButton);
-        RectShape bowlDraw = shiftRect(bowlOutline);
-        float bowlInnerX = bowlDraw.x + bowlThickness;
-        float bowlInnerY = bowlDraw.y + bowlThickness;
-        float bowlInnerW = bowlDraw.w - 2.0f * bowlThickness;
-        float bowlInnerH = bowlDraw.h - 2.0f * bowlThickness;
+    std::vector<InputEvent> inputEvents;
 
-        if (clickStarted && !appState.lockedByFullBowl)
+    // Turns queued GLFW events into simulation commands, keeping each event's own
+    // timestamp so the simulation applies it on the tick it actually happened in.
+    auto forwardInput = [&]()
+    {
+        ScopedPhaseTimer inputTimer(profiler, ProfilePhase::Input);
+        input.drain(inputEvents);
+        for (const InputEvent& e : inputEvents)
         {
-            if (pointInRect(mouseX, mouseY, tempArrowDraw))
+            // Dashboard view controls: right-drag pans, the wheel zooms at the cursor.
+            if (dashboard)
             {
-                float midY = tempArrowDraw.y + tempArrowDraw.h * 0.5f;
-                if (mouseY < midY)
+                if (e.type == InputEventType::MouseButton && e.code == GLFW_MOUSE_BUTTON_RIGHT)
                 {
-                    appState.desiredTemp += appState.tempChangeStep;
+                    dragging = e.action == GLFW_PRESS;
+                    dragX = e.x;
+                    dragY = e.y;
+                    continue;
                 }
-                else
+                if (e.type == InputEventType::CursorMove)
+                {
+                    if (dragging) dashboard->pan(static_cast<float>(e.x - dragX), static_cast<float>(e.y - dragY));
+                    dragX = e.x;
+                    dragY = e.y;
+                    continue;
+                }
+                if (e.type == InputEventType::Scroll)
+                {
+                    dashboard->zoomAt(std::pow(DASHBOARD_ZOOM_STEP, static_cast<float>(e.scroll)), static_cast<float>(e.x), static_cast<float>(e.y));
+                    continue;
+                }
+                if (e.type == InputEventType::Key && e.action != GLFW_RELEASE)
                 {
-                    appState.desiredTemp -= appState.tempChangeStep;
+                    float centerX = static_cast<float>(windowWidth) * 0.5f;
+                    float centerY = static_cast<float>(windowHeight) * 0.5f;
+                    bool handled = true;
+                    switch (e.code)
+                    {
+                    case GLFW_KEY_W: dashboard->pan(0.0f, DASHBOARD_PAN_STEP); break;
+                    case GLFW_KEY_S: dashboard->pan(0.0f, -DASHBOARD_PAN_STEP); break;
+                    case GLFW_KEY_A: dashboard->pan(DASHBOARD_PAN_STEP, 0.0f); break;
+                    case GLFW_KEY_D: dashboard->pan(-DASHBOARD_PAN_STEP, 0.0f); break;
+                    case GLFW_KEY_EQUAL:
+                    case GLFW_KEY_KP_ADD: dashboard->zoomAt(DASHBOARD_ZOOM_STEP, centerX, centerY); break;
+                    case GLFW_KEY_MINUS:
+                    case GLFW_KEY_KP_SUBTRACT: dashboard->zoomAt(1.0f / DASHBOARD_ZOOM_STEP, centerX, centerY); break;
+                    case GLFW_KEY_HOME: dashboard->fitAll(); break;
+                    default: handled = false; break;
+                    }
+                    if (handled) continue;
                 }
             }
 
-            if (appState.desiredTemp < -10.0f) appState.desiredTemp = -10.0f;
-            if (appState.desiredTemp > 40.0f) appState.desiredTemp = 40.0f;
-        }
-
-        handlePowerToggle(appState, mouseX, mouseY, mouseDown, lampDraw);
-        handleTemperatureInput(appState, upPressed, downPressed);
-        updateVent(appState, deltaTime);
-        updateTemperature(appState, deltaTime);
-        updateWater(appState, deltaTime, spacePressed);
+            if (e.action != GLFW_PRESS) continue;
 
-        lampDraw.color = appState.isOn ? lampOnColor : lampOffColor;
-        float ventHeight = ventClosedHeight + (ventOpenHeight - ventClosedHeight) * appState.ventOpenness;
-        ventBarDraw.h = ventHeight;
+            // Keys act on the selected unit; in single-unit mode that is unit 0.
+            std::size_t unit = dashboard ? static_cast<std::size_t>(dashboard->selected()) : 0;
 
-        Color screenColor = appState.isOn ? screenOnColor : screenOffColor;
-
-        glClear(GL_COLOR_BUFFER_BIT);
+            if (e.type == InputEventType::MouseButton)
+            {
+                if (e.code != GLFW_MOUSE_BUTTON_LEFT) continue;
 
-        renderer.drawRect(acBodyDraw.x, acBodyDraw.y, acBodyDraw.w, acBodyDraw.h, acBodyDraw.color);
-        renderer.drawRect(ventBarDraw.x, ventBarDraw.y, ventBarDraw.w, ventBarDraw.h, ventBarDraw.color);
-        renderer.drawCircle(lampDraw.x, lampDraw.y, lampDraw.radius, lampDraw.color);
+                int control = -1;
+                if (dashboard)
+                {
+                    DashboardControl picked;
+                    int pickedUnit = dashboard->pick(e.x, e.y, picked);
+                    if (pickedUnit < 0) continue;
+                    dashboard->setSelected(pickedUnit);
+                    unit = static_cast<std::size_t>(pickedUnit);
+                    control = picked == DashboardControl::TemperatureUp ? CONTROL_TEMP_UP
+                        : picked == DashboardControl::TemperatureDown ? CONTROL_TEMP_DOWN
+                        : picked == DashboardControl::Power ? CONTROL_POWER : -1;
+                }
+                else
+                {
+                    control = layout.hitTest(e.x, e.y);
+                }
 
-        for (const auto& screen : screensDraw)
-        {
-            renderer.drawRect(screen.x, screen.y, screen.w, screen.h, screenColor);
-        }
+                if (simulation.snapshot().units[unit].lockedByFullBowl) continue;
+                switch (control)
+                {
+                case CONTROL_TEMP_UP: simulation.pushInput(InputCommand::TemperatureUp, e.timestamp, unit); break;
+                case CONTROL_TEMP_DOWN: simulation.pushInput(InputCommand::TemperatureDown, e.timestamp, unit); break;
+                case CONTROL_POWER: simulation.pushInput(InputCommand::TogglePower, e.timestamp, unit); break;
+                default: break;
+                }
+                continue;
+            }
+            if (e.type != InputEventType::Key) continue;
 
-        if (appState.isOn)
-        {
-            drawTemperatureValue(textRenderer, appState.desiredTemp, screensDraw[0], digitColor);
-            drawTemperatureValue(textRenderer, appState.currentTemp, screensDraw[1], digitColor);
-            drawStatusIcon(renderer, screensDraw[2], appState.desiredTemp, appState.currentTemp);
+            switch (e.code)
+            {
+            case GLFW_KEY_UP: simulation.pushInput(InputCommand::TemperatureUp, e.timestamp, unit); break;
+            case GLFW_KEY_DOWN: simulation.pushInput(InputCommand::TemperatureDown, e.timestamp, unit); break;
+            case GLFW_KEY_SPACE: simulation.pushInput(InputCommand::DrainBowl, e.timestamp, unit); break;
+            case GLFW_KEY_ESCAPE: glfwSetWindowShouldClose(window, GLFW_TRUE); break;
+            case GLFW_KEY_F3: showProfiler = !showProfiler; damage.markDirty(); break;
+            case GLFW_KEY_F9: writeTrace(); break;
+            // Page Up/Down retune the frame limiter in 15 FPS steps.
+            case GLFW_KEY_PAGE_UP: pacer.setTargetFps(pacer.targetFps() + 15.0); break;
+            case GLFW_KEY_PAGE_DOWN: if (pacer.targetFps() > 15.0) pacer.setTargetFps(pacer.targetFps() - 15.0); break;
+            default: break;
+            }
         }
+    };
 
-        if (appState.waterLevel > 0.0f)
+    // Frame stats and the nameplate, drawn on top of either view.
+    auto drawOverlays = [&](const std::string& statsText)
+    {
+        if (!statsText.empty())
         {
-            float waterHeight = bowlInnerH * appState.waterLevel;
-            float waterY = bowlInnerY + bowlInnerH - waterHeight;
-            renderer.drawRect(bowlInnerX, waterY, bowlInnerW, waterHeight, waterColor);
+            float statsScale = 0.6f;
+            float margin = 16.0f;
+            textRenderer.drawText(statsText, margin, margin, statsScale, kUnitDigitColor);
         }
-        renderer.drawFrame(bowlDraw, bowlThickness);
-        RectShape arrowTop{ tempArrowDraw.x, tempArrowDraw.y, tempArrowDraw.w, tempArrowDraw.h * 0.5f, arrowBg };
-        RectShape arrowBottom{ tempArrowDraw.x, tempArrowDraw.y + tempArrowDraw.h * 0.5f, tempArrowDraw.w, tempArrowDraw.h * 0.5f, arrowBg };
-        drawHalfArrow(renderer, arrowTop, true, arrowColor, arrowBg);
-        drawHalfArrow(renderer, arrowBottom, false, arrowColor, arrowBg);
 
-        if (!frameStats.empty())
+        if (showProfiler && !isHeadless)
         {
-            float statsScale = 0.6f;
-            float margin = 16.0f;
-            textRenderer.drawText(frameStats, margin, margin, statsScale, digitColor);
+            float scale = 0.45f;
+            float lineHeight = 26.0f;
+            float y = 48.0f;
+            for (const std::string& line : profileLines)
+            {
+                textRenderer.drawText(line, 16.0f, y, scale, kUnitDigitColor);
+                y += lineHeight;
+            }
         }
 
         if (nameplateTexture != 0)
@@ -327,31 +606,277 @@ int main()
                 { overlayX + nameplateW,             overlayY + nameplateH, 1.0f, 0.0f },
             };
 
-            glUseProgram(overlayProgram);
-            glUniform2f(overlayWindowSizeLoc, static_cast<float>(windowWidth), static_cast<float>(windowHeight));
-            glUniform4f(overlayTintLoc, 1.0f, 1.0f, 1.0f, 1.0f);
-            glUniform1i(overlayTextureLoc, 0);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, nameplateTexture);
-
-            glBindVertexArray(overlayVao);
-            glBindBuffer(GL_ARRAY_BUFFER, overlayVbo);
+            GLuint overlayProgram = shaderManager().program(overlayShader);
+            if (shaderManager().version(overlayShader) != overlayShaderVersion)
+            {
+                overlayShaderVersion = shaderManager().version(overlayShader);
+                overlayWindowSizeLoc = glGetUniformLocation(overlayProgram, "uWindowSize");
+                overlayTintLoc = glGetUniformLocation(overlayProgram, "uTint");
+                overlayTextureLoc = glGetUniformLocation(overlayProgram, "uTexture");
+            }
+            glState().useProgram(overlayProgram);
+            glState().uniform2f(overlayWindowSizeLoc, static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+            glState().uniform4f(overlayTintLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+            glState().uniform1i(overlayTextureLoc, 0);
+            glState().activeTexture(GL_TEXTURE0);
+            glState().bindTexture2D(nameplateTexture);
+
+            glState().bindVertexArray(overlayVao);
+            glState().bindArrayBuffer(overlayVbo);
             glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
             glDrawArrays(GL_TRIANGLES, 0, 6);
-            glBindVertexArray(0);
+        }
+    };
+
+    // Presents the frame (if one was drawn), then waits in the event loop rather
+    // than a plain sleep, so input reaches the simulation as it arrives instead of
+    // once per frame. A positive idleWait means power-save: sleep until an event
+    // or that timeout instead of pacing.
+    auto finishFrame = [&](bool present, double idleWait)
+    {
+        ScopedPhaseTimer swapTimer(profiler, ProfilePhase::SwapSleep);
+        if (isHeadless)
+        {
+            // Nothing to present or wait for; optionally keep the frame for pixel diffs.
+            if (!dumpDir.empty())
+            {
+                char name[32];
+                std::snprintf(name, sizeof(name), "/frame_%05d.ppm", headlessFrame);
+                offscreen->writePpm(dumpDir + name);
+            }
+            damage.markPresented();
+            if (++headlessFrame >= headlessFrames) glfwSetWindowShouldClose(window, GLFW_TRUE);
+            return;
+        }
+
+        if (present)
+        {
+            glfwSwapBuffers(window);
+            damage.markPresented();
+        }
+
+        if (idleWait > 0.0)
+        {
+            glfwWaitEventsTimeout(idleWait);
+            forwardInput();
+        }
+        else
+        {
+            glfwPollEvents();
+            forwardInput();
+            pacer.waitForNextFrame([&](double seconds)
+            {
+                glfwWaitEventsTimeout(seconds);
+                forwardInput();
+            });
+        }
+    };
+
+    // Called only for frames that are drawn, so power-save wakeups neither count toward
+    // the FPS nor force a redraw; the label picks up new stats on the next real frame.
+    auto beginDrawnFrame = [&]()
+    {
+        pacer.beginFrame();
+        FrameTimeStats stats;
+        if (!isHeadless && pacer.takeStats(stats))
+        {
+            double avgFps = stats.meanMs > 0.0 ? 1000.0 / stats.meanMs : 0.0;
+            char buf[96];
+            std::snprintf(buf, sizeof(buf), "FPS %.1f  sd %.2f ms  max %.1f ms", avgFps, stats.stdDevMs, stats.maxMs); // once per second
+            frameStats = buf;
+        }
+    };
+
+    std::chrono::steady_clock::time_point loopStart = std::chrono::steady_clock::now();
+    while (!glfwWindowShouldClose(window))
+    {
+        AC_TRACE_SCOPE("frame");
+        profiler.endFrame();
+        ++framesSinceReport;
+        if (profiler.takeReport(profileReport))
+        {
+            profileLines.clear();
+            profileLines.push_back("phase (ms)      p50     p95     p99     max");
+            for (size_t i = 0; i < profileReport.size(); ++i)
+            {
+                const PhaseStats& phase = profileReport[i];
+                char buf[128];
+                std::snprintf(buf, sizeof(buf), "%-12s %7.3f %7.3f %7.3f %7.3f", profilePhaseName(static_cast<ProfilePhase>(i)), phase.p50Ms, phase.p95Ms, phase.p99Ms, phase.maxMs);
+                profileLines.push_back(buf);
+            }
+
+            // Same window as the CPU phases, so both halves of the overlay line up.
+            gpuTimer.takeReport(gpuReport, 0.0);
+            profileLines.push_back("gpu pass (ms)   mean     max");
+            for (size_t i = 0; i < gpuReport.size(); ++i)
+            {
+                const GpuPassStats& pass = gpuReport[i];
+                char buf[128];
+                std::snprintf(buf, sizeof(buf), "%-12s %7.3f %7.3f", gpuPassName(static_cast<GpuPass>(i)), pass.meanMs, pass.maxMs);
+                profileLines.push_back(buf);
+            }
+
+            const GlCallCounters& glCalls = glState().counters();
+            char glBuf[128];
+            std::snprintf(glBuf, sizeof(glBuf), "gl state/frame  issued %.0f  elided %.0f",
+                static_cast<double>(glCalls.issued - glCallsAtReport.issued) / std::max(framesSinceReport, 1),
+                static_cast<double>(glCalls.elided - glCallsAtReport.elided) / std::max(framesSinceReport, 1));
+            profileLines.push_back(glBuf);
+            glCallsAtReport = glCalls;
+            framesSinceReport = 0;
+            if (showProfiler) damage.markDirty();
         }
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        if (shaderWatcher && shaderWatcher->takeChanges(changedShaders))
+        {
+            for (const std::string& name : changedShaders) shaderManager().reload(name);
+            changedShaders.clear();
+        }
+        if (shaderManager().update())
+        {
+            damage.markDirty();
+        }
+        if (textureLoader().update(TEXTURE_UPLOAD_BUDGET))
+        {
+            damage.markDirty();
+        }
 
-        auto targetTime = frameStartTime + std::chrono::duration<double>(TARGET_FRAME_TIME);
-        auto now = std::chrono::steady_clock::now();
-        if (now < targetTime)
+        ScopedPhaseTimer sceneTimer(profiler, ProfilePhase::SceneBuild);
+
+        if (isHeadless)
         {
-            std::this_thread::sleep_until(targetTime); // coarse frame limiter to ~75 FPS
+            simulation.advance(headlessTicksPerFrame);
         }
+        simulation.updateSnapshot();
+
+        if (temperatureGraph.update()) damage.markDirty();
+
+        if (recorder.isOpen())
+        {
+            TelemetrySample pending[64];
+            std::size_t count;
+            while ((count = recorderReader.poll(pending, 64)) > 0)
+            {
+                for (std::size_t i = 0; i < count; ++i) recorder.append(pending[i]);
+            }
+        }
+
+        // Dashboard: everything is drawn by the grid view; power-save does not apply
+        // because some unit is almost always animating.
+        if (dashboard)
+        {
+            sceneTimer.stop();
+            beginDrawnFrame();
+            ScopedPhaseTimer drawTimer(profiler, ProfilePhase::DrawSubmit);
+            gpuTimer.beginFrame();
+            gpuTimer.begin(GpuPass::Clear);
+            glClear(GL_COLOR_BUFFER_BIT);
+            // Every unit's shapes in the body pass, then all their digits in one text run.
+            renderer.setQueue(&renderQueue);
+            textRenderer.setQueue(&renderQueue);
+            renderQueue.setLayer(passLayer(GpuPass::Body));
+            int visible = dashboard->draw(renderer, textRenderer, simulation.snapshot().units, &renderQueue);
+            renderQueue.flush(renderer, textRenderer, beginPassForLayer);
+            gpuTimer.begin(GpuPass::Overlay);
+            drawOverlays(frameStats + "  units " + std::to_string(visible) + "/" + std::to_string(dashboard->unitCount()));
+            gpuTimer.end();
+            drawTimer.stop();
+            finishFrame(true, 0.0);
+            continue;
+        }
+
+        const AppState& appState = simulation.snapshot().units[0];
+
+        // Placed shapes are cached by the layout and only change on resize.
+        const SceneShapes& scene = layout.placed();
+        const RectShape& bowlInner = layout.bowlInner();
+
+        Color lampColor = appState.isOn ? kUnitLampOnColor : kUnitLampOffColor;
+        float ventHeight = kUnitVentClosedH + (kUnitVentOpenH - kUnitVentClosedH) * appState.ventOpenness;
+
+        Color screenColor = appState.isOn ? kUnitScreenOnColor : kUnitScreenOffColor;
+
+        // Power-save: nothing visible changed, so skip clear/draw/swap and sleep until
+        // an event arrives or it is time to look at the next snapshot.
+        damage.checkState(appState);
+        bool animating = appState.isOn || (appState.ventOpenness > 0.0f && appState.ventOpenness < 1.0f);
+        double powerSaveWait = animating && pacer.targetFps() > 0.0 ? 1.0 / pacer.targetFps() : POWER_SAVE_IDLE_WAIT;
+        if (powerSave && !damage.isDirty())
+        {
+            sceneTimer.stop();
+            finishFrame(false, powerSaveWait);
+            continue;
+        }
+        sceneTimer.stop();
+        beginDrawnFrame();
+
+        ScopedPhaseTimer drawTimer(profiler, ProfilePhase::DrawSubmit);
+        gpuTimer.beginFrame();
+        gpuTimer.begin(GpuPass::Clear);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // The scene is recorded, then drawn sorted pass by pass; inside a pass the shapes
+        // keep their painter's order and the digits follow them. Overlays stay immediate.
+        // The arrows sit on the body and overlap nothing else, so they are drawn in its pass.
+        renderer.setQueue(&renderQueue);
+        textRenderer.setQueue(&renderQueue);
+        renderQueue.setLayer(passLayer(GpuPass::Body));
+        renderer.drawRect(scene.body.x, scene.body.y, scene.body.w, scene.body.h, scene.body.color);
+        renderer.drawRect(scene.vent.x, scene.vent.y, scene.vent.w, ventHeight, scene.vent.color);
+        renderer.drawCircle(scene.lamp.x, scene.lamp.y, scene.lamp.radius, lampColor);
+        drawHalfArrow(renderer, layout.arrowUp(), true, kUnitArrowColor, kUnitArrowBg);
+        drawHalfArrow(renderer, layout.arrowDown(), false, kUnitArrowColor, kUnitArrowBg);
+
+        renderQueue.setLayer(passLayer(GpuPass::ScreensText));
+        for (const auto& screen : scene.screens)
+        {
+            renderer.drawRect(screen.x, screen.y, screen.w, screen.h, screenColor);
+        }
+
+        if (appState.isOn)
+        {
+            drawTemperatureValue(textRenderer, appState.desiredTemp, scene.screens[0], kUnitDigitColor);
+            drawTemperatureValue(textRenderer, appState.currentTemp, scene.screens[1], kUnitDigitColor);
+            renderQueue.setLayer(passLayer(GpuPass::StatusIcon));
+            drawStatusIcon(renderer, scene.screens[2], appState.desiredTemp, appState.currentTemp);
+        }
+
+        renderQueue.setLayer(passLayer(GpuPass::Bowl));
+        if (appState.waterLevel > 0.0f)
+        {
+            float waterHeight = bowlInner.h * appState.waterLevel;
+            float waterY = bowlInner.y + bowlInner.h - waterHeight;
+            renderer.drawRect(bowlInner.x, waterY, bowlInner.w, waterHeight, kUnitWaterColor);
+        }
+        renderer.drawFrame(scene.bowl, kUnitBowlThickness);
+
+        renderQueue.setLayer(passLayer(GpuPass::Graph));
+        temperatureGraph.draw(renderer, scene.graph, graphCurrentColor, graphDesiredColor);
+
+        renderQueue.flush(renderer, textRenderer, beginPassForLayer);
+
+        gpuTimer.begin(GpuPass::Overlay);
+        drawOverlays(frameStats);
+        gpuTimer.end();
+        drawTimer.stop();
+
+        finishFrame(true, powerSave ? powerSaveWait : 0.0);
+    }
+
+    if (isHeadless)
+    {
+        glFinish();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+        std::printf("Headless: %d frames at %dx%d in %.3f s (%.3f ms/frame, %.1f FPS)\n",
+            headlessFrame, fbWidth, fbHeight, seconds, seconds * 1000.0 / std::max(headlessFrame, 1), headlessFrame / std::max(seconds, 1e-9));
     }
 
+    simulation.stop();
+    if (!tracePath.empty()) writeTrace();
+    recorder.close();
+    shaderWatcher.reset();
+    textureLoader().clear();
+    shaderManager().clear();
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
@@ -0,0 +1,133 @@
+#include "../Header/Profiler.h"
+
+#include "../Header/Trace.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const char* kPhaseNames[] = { "input", "sim tick", "scene", "draw", "swap/sleep" };
+}
+
+const char* profilePhaseName(ProfilePhase phase)
+{
+    return kPhaseNames[static_cast<int>(phase)];
+}
+
+FrameProfiler::FrameProfiler()
+    : m_windowStart(std::chrono::steady_clock::now())
+{
+    for (Histogram& histogram : m_histograms)
+    {
+        for (auto& bucket : histogram.buckets) bucket.store(0, std::memory_order_relaxed);
+        histogram.maxNs.store(0, std::memory_order_relaxed);
+    }
+}
+
+void FrameProfiler::record(ProfilePhase phase, double seconds)
+{
+    double ns = std::max(seconds * 1e9, 1.0);
+    int bucket = static_cast<int>(std::log2(ns) * kBucketsPerOctave);
+    bucket = std::min(std::max(bucket, 0), kBucketCount - 1);
+
+    Histogram& histogram = m_histograms[static_cast<size_t>(phase)];
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    std::uint64_t value = static_cast<std::uint64_t>(ns);
+    std::uint64_t seen = histogram.maxNs.load(std::memory_order_relaxed);
+    while (value > seen && !histogram.maxNs.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void FrameProfiler::accumulate(ProfilePhase phase, double seconds)
+{
+    m_frameTotals[static_cast<size_t>(phase)] += seconds;
+}
+
+void FrameProfiler::endFrame()
+{
+    for (size_t i = 0; i < m_frameTotals.size(); ++i)
+    {
+        if (m_frameTotals[i] > 0.0)
+        {
+            record(static_cast<ProfilePhase>(i), m_frameTotals[i]);
+            m_frameTotals[i] = 0.0;
+        }
+    }
+}
+
+bool FrameProfiler::takeReport(ProfileReport& out, double intervalSeconds)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - m_windowStart).count() < intervalSeconds) return false;
+    m_windowStart = now;
+
+    for (size_t phase = 0; phase < m_histograms.size(); ++phase)
+    {
+        // Samples landing while this runs go to either window; a percentile overlay can live with that.
+        Histogram& histogram = m_histograms[phase];
+        std::array<std::uint32_t, kBucketCount> counts;
+        std::uint32_t total = 0;
+        for (int i = 0; i < kBucketCount; ++i)
+        {
+            counts[i] = histogram.buckets[i].exchange(0, std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        PhaseStats& stats = out[phase];
+        stats = PhaseStats();
+        stats.samples = total;
+        stats.maxMs = histogram.maxNs.exchange(0, std::memory_order_relaxed) / 1e6;
+        if (total == 0) continue;
+
+        // Report each percentile as the upper edge of its bucket, capped at the true max.
+        auto percentile = [&](double p)
+        {
+            std::uint32_t rank = static_cast<std::uint32_t>(std::ceil(p * total));
+            std::uint32_t seen = 0;
+            for (int i = 0; i < kBucketCount; ++i)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                {
+                    double upperNs = std::exp2(static_cast<double>(i + 1) / kBucketsPerOctave);
+                    return std::min(upperNs / 1e6, stats.maxMs);
+                }
+            }
+            return stats.maxMs;
+        };
+        stats.p50Ms = percentile(0.50);
+        stats.p95Ms = percentile(0.95);
+        stats.p99Ms = percentile(0.99);
+    }
+    return true;
+}
+
+ScopedPhaseTimer::ScopedPhaseTimer(FrameProfiler& profiler, ProfilePhase phase)
+    : m_profiler(profiler)
+    , m_phase(phase)
+    , m_parent(profiler.m_activeTimer)
+    , m_start(std::chrono::steady_clock::now())
+{
+    profiler.m_activeTimer = this;
+    AC_TRACE_BEGIN(profilePhaseName(phase));
+}
+
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+    stop();
+}
+
+void ScopedPhaseTimer::stop()
+{
+    if (!m_running) return;
+    m_running = false;
+    AC_TRACE_END();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    m_profiler.accumulate(m_phase, std::max(elapsed - m_childSeconds, 0.0));
+    if (m_parent) m_parent->m_childSeconds += elapsed;
+    m_profiler.m_activeTimer = m_parent;
+}
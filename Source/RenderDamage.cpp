@@ -0,0 +1,38 @@
+#include "../Header/RenderDamage.h"
+
+#include "../Header/Controller.h"
+
+#include <cmath>
+
+RenderDamage::VisualKey RenderDamage::makeKey(const AppState& state)
+{
+    VisualKey key;
+    key.isOn = state.isOn;
+    key.lockedByFullBowl = state.lockedByFullBowl;
+    key.ventOpenness = state.ventOpenness;
+    key.waterLevel = state.waterLevel;
+    key.desiredShown = static_cast<int>(std::round(state.desiredTemp));
+    key.currentShown = static_cast<int>(std::round(state.currentTemp));
+
+    float diff = state.desiredTemp - state.currentTemp;
+    key.statusIcon = diff > kTemperatureTolerance ? 1 : (diff < -kTemperatureTolerance ? -1 : 0);
+    return key;
+}
+
+void RenderDamage::checkState(const AppState& state)
+{
+    VisualKey key = makeKey(state);
+    bool changed = key.isOn != m_last.isOn
+        || key.lockedByFullBowl != m_last.lockedByFullBowl
+        || key.ventOpenness != m_last.ventOpenness
+        || key.waterLevel != m_last.waterLevel
+        || key.desiredShown != m_last.desiredShown
+        || key.currentShown != m_last.currentShown
+        || key.statusIcon != m_last.statusIcon;
+
+    if (changed)
+    {
+        m_last = key;
+        m_dirty = true;
+    }
+}
@@ -0,0 +1,180 @@
+#include "../Header/RenderQueue.h"
+
+#include "../Header/TextRenderer.h"
+#include "../Header/Trace.h"
+
+#include <array>
+
+namespace
+{
+    // Keys use the low 48 bits: layer, program and a 32-bit sequence.
+    const int kKeyBytes = 6;
+
+    // LSD radix sort on whole keys, one byte per pass. All histograms are built in
+    // a single read, and a byte that is the same in every key (often the layer or
+    // the upper sequence bits) skips its pass entirely.
+    void radixSort(std::vector<std::uint64_t>& keys, std::vector<std::uint64_t>& scratch)
+    {
+        const size_t n = keys.size();
+        if (n < 2) return;
+
+        std::array<std::array<std::uint32_t, 256>, kKeyBytes> counts{};
+        for (std::uint64_t key : keys)
+        {
+            for (int pass = 0; pass < kKeyBytes; ++pass)
+            {
+                ++counts[pass][(key >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        scratch.resize(n);
+        std::vector<std::uint64_t>* from = &keys;
+        std::vector<std::uint64_t>* to = &scratch;
+        for (int pass = 0; pass < kKeyBytes; ++pass)
+        {
+            std::array<std::uint32_t, 256>& count = counts[pass];
+            if (count[((*from)[0] >> (pass * 8)) & 0xFF] == n) continue;
+
+            std::uint32_t offset = 0;
+            for (std::uint32_t& c : count)
+            {
+                std::uint32_t next = offset + c;
+                c = offset;
+                offset = next;
+            }
+            for (std::uint64_t key : *from)
+            {
+                (*to)[count[(key >> (pass * 8)) & 0xFF]++] = key;
+            }
+            std::swap(from, to);
+        }
+        if (from != &keys) keys.swap(scratch);
+    }
+}
+
+RenderQueue::Command& RenderQueue::push(Kind kind, RenderProgramId program)
+{
+    std::uint64_t sequence = static_cast<std::uint64_t>(m_commands.size());
+    m_keys.push_back((static_cast<std::uint64_t>(m_layer) << 40)
+        | (static_cast<std::uint64_t>(program) << 32)
+        | sequence);
+    m_commands.emplace_back();
+    m_commands.back().kind = kind;
+    return m_commands.back();
+}
+
+void RenderQueue::rect(float x, float y, float w, float h, const Color& color)
+{
+    Command& command = push(Kind::Rect, RenderProgramId::Basic);
+    command.color = color;
+    command.v[0] = x;
+    command.v[1] = y;
+    command.v[2] = w;
+    command.v[3] = h;
+}
+
+void RenderQueue::circle(float cx, float cy, float radius, const Color& color, int segments)
+{
+    Command& command = push(Kind::Circle, RenderProgramId::Basic);
+    command.color = color;
+    command.v[0] = cx;
+    command.v[1] = cy;
+    command.v[2] = radius;
+    command.segments = segments;
+}
+
+void RenderQueue::triangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color)
+{
+    Command& command = push(Kind::Triangle, RenderProgramId::Basic);
+    command.color = color;
+    command.v[0] = x1;
+    command.v[1] = y1;
+    command.v[2] = x2;
+    command.v[3] = y2;
+    command.v[4] = x3;
+    command.v[5] = y3;
+}
+
+void RenderQueue::lineStrips(const std::vector<float>& points, const std::vector<LineStrip>& strips)
+{
+    Command& command = push(Kind::LineStrips, RenderProgramId::Basic);
+    command.first = static_cast<std::uint32_t>(m_floats.size());
+    command.count = static_cast<std::uint32_t>(points.size());
+    command.stripFirst = static_cast<std::uint32_t>(m_strips.size());
+    command.stripCount = static_cast<std::uint32_t>(strips.size());
+    m_floats.insert(m_floats.end(), points.begin(), points.end());
+    m_strips.insert(m_strips.end(), strips.begin(), strips.end());
+}
+
+void RenderQueue::rects(const std::vector<float>& rects, const Color& color)
+{
+    Command& command = push(Kind::Rects, RenderProgramId::Basic);
+    command.color = color;
+    command.first = static_cast<std::uint32_t>(m_floats.size());
+    command.count = static_cast<std::uint32_t>(rects.size());
+    m_floats.insert(m_floats.end(), rects.begin(), rects.end());
+}
+
+void RenderQueue::text(const std::string& text, float x, float y, float scale, const Color& color)
+{
+    Command& command = push(Kind::Text, RenderProgramId::Text);
+    command.color = color;
+    command.v[0] = x;
+    command.v[1] = y;
+    command.v[2] = scale;
+    if (m_textCount == m_texts.size()) m_texts.emplace_back();
+    m_texts[m_textCount] = text; // assign, so the slot's capacity is reused
+    command.first = static_cast<std::uint32_t>(m_textCount++);
+}
+
+void RenderQueue::flush(Renderer2D& renderer, TextRenderer& textRenderer, const LayerCallback& onLayer)
+{
+    AC_TRACE_SCOPE("RenderQueue::flush");
+    renderer.setQueue(nullptr);
+    textRenderer.setQueue(nullptr);
+
+    radixSort(m_keys, m_sortScratch);
+    int currentLayer = -1;
+    for (std::uint64_t key : m_keys)
+    {
+        int layer = static_cast<int>((key >> 40) & 0xFF);
+        if (layer != currentLayer)
+        {
+            currentLayer = layer;
+            if (onLayer) onLayer(static_cast<std::uint8_t>(layer));
+        }
+        const Command& command = m_commands[static_cast<size_t>(key & 0xFFFFFFFFu)];
+        const float* v = command.v;
+        switch (command.kind)
+        {
+        case Kind::Rect:
+            renderer.drawRect(v[0], v[1], v[2], v[3], command.color);
+            break;
+        case Kind::Circle:
+            renderer.drawCircle(v[0], v[1], v[2], command.color, command.segments);
+            break;
+        case Kind::Triangle:
+            renderer.drawTriangle(v[0], v[1], v[2], v[3], v[4], v[5], command.color);
+            break;
+        case Kind::LineStrips:
+            m_replayFloats.assign(m_floats.begin() + command.first, m_floats.begin() + command.first + command.count);
+            m_replayStrips.assign(m_strips.begin() + command.stripFirst, m_strips.begin() + command.stripFirst + command.stripCount);
+            renderer.drawLineStrips(m_replayFloats, m_replayStrips);
+            break;
+        case Kind::Rects:
+            m_replayFloats.assign(m_floats.begin() + command.first, m_floats.begin() + command.first + command.count);
+            renderer.drawRects(m_replayFloats, command.color);
+            break;
+        case Kind::Text:
+            textRenderer.drawText(m_texts[command.first], v[0], v[1], v[2], command.color);
+            break;
+        }
+    }
+
+    m_commands.clear();
+    m_keys.clear();
+    m_floats.clear();
+    m_strips.clear();
+    m_textCount = 0;
+    m_layer = 0;
+}
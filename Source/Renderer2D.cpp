@@ -1,5 +1,7 @@
 #include "../Header/Renderer2D.h"
 
+#include "../Header/GlState.h"
+#include "../Header/RenderQueue.h"
 #include "../Header/Util.h"
 
 #include <cmath>
@@ -7,6 +9,43 @@
 
 namespace
 {
+    // Max distance between the true circle and its polygon, in pixels.
+    const float kCircleTolerancePx = 0.25f;
+    const int kCircleLodSegments[] = { 8, 12, 16, 24, 32, 48, 64, 96, 128 };
+    const int kCircleLodCount = static_cast<int>(sizeof(kCircleLodSegments) / sizeof(kCircleLodSegments[0]));
+
+    // Unit-circle x,y pairs for every LOD level, built once so drawing never calls cos/sin.
+    const std::vector<float>& unitCircle(int level)
+    {
+        static const std::vector<std::vector<float>> tables = []()
+        {
+            std::vector<std::vector<float>> out(kCircleLodCount);
+            const double twoPi = 6.283185307179586;
+            for (int lod = 0; lod < kCircleLodCount; ++lod)
+            {
+                int segments = kCircleLodSegments[lod];
+                out[lod].resize(segments * 2);
+                for (int i = 0; i < segments; ++i)
+                {
+                    double angle = twoPi * i / segments;
+                    out[lod][i * 2] = static_cast<float>(std::cos(angle));
+                    out[lod][i * 2 + 1] = static_cast<float>(std::sin(angle));
+                }
+            }
+            return out;
+        }();
+        return tables[level];
+    }
+
+    int circleLodFor(int segments)
+    {
+        for (int level = 0; level < kCircleLodCount; ++level)
+        {
+            if (kCircleLodSegments[level] >= segments) return level;
+        }
+        return kCircleLodCount - 1;
+    }
+
     void fillRectVertices(float x, float y, float w, float h, float windowWidth, float windowHeight, float* outVertices)
     {
         // Convert from pixel coords (origin top-left) to NDC (-1..1)
@@ -30,26 +69,36 @@ Renderer2D::Renderer2D(int windowWidth, int windowHeight, const char* vertexShad
     : m_windowWidth(static_cast<float>(windowWidth))
     , m_windowHeight(static_cast<float>(windowHeight))
 {
-    m_program = createShader(vertexShaderPath, fragmentShaderPath);
-    m_uColorLocation = glGetUniformLocation(m_program, "uColor");
+    m_shader = shaderManager().submit(vertexShaderPath, fragmentShaderPath);
 
     glGenVertexArrays(1, &m_vao);
     glGenBuffers(1, &m_vbo);
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glState().bindVertexArray(m_vao);
+    glState().bindArrayBuffer(m_vbo);
 
     float initialVertices[12] = { 0.0f };
     glBufferData(GL_ARRAY_BUFFER, sizeof(initialVertices), initialVertices, GL_DYNAMIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glBindVertexArray(0);
 }
 
 Renderer2D::~Renderer2D()
 {
     if (m_vbo != 0) glDeleteBuffers(1, &m_vbo);
     if (m_vao != 0) glDeleteVertexArrays(1, &m_vao);
-    if (m_program != 0) glDeleteProgram(m_program);
+    glState().invalidate();
+}
+
+void Renderer2D::useProgram() const
+{
+    GLuint program = shaderManager().program(m_shader);
+    unsigned int version = shaderManager().version(m_shader);
+    if (version != m_shaderVersion)
+    {
+        m_shaderVersion = version;
+        m_uColorLocation = glGetUniformLocation(program, "uColor");
+    }
+    glState().useProgram(program);
 }
 
 void Renderer2D::setWindowSize(float width, float height)
@@ -60,52 +109,59 @@ void Renderer2D::setWindowSize(float width, float height)
 
 void Renderer2D::drawRect(float x, float y, float w, float h, const Color& color) const
 {
+    if (m_queue)
+    {
+        m_queue->rect(x, y, w, h, color);
+        return;
+    }
+
     float vertices[12];
     fillRectVertices(x, y, w, h, m_windowWidth, m_windowHeight, vertices);
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glState().bindArrayBuffer(m_vbo);
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
-    glUseProgram(m_program);
-    glUniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
-    glBindVertexArray(m_vao);
+    useProgram();
+    glState().uniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
+    glState().bindVertexArray(m_vao);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
 }
 
-void Renderer2D::drawCircle(float cx, float cy, float radius, const Color& color, int segments) const
+int circleSegmentsFor(float radiusPx)
 {
-    // Fan triangulation for filled circle.
-    std::vector<float> vertices;
-    vertices.reserve((segments + 2) * 2);
-
-    float centerX = 2.0f * cx / m_windowWidth - 1.0f;
-    float centerY = 1.0f - 2.0f * cy / m_windowHeight;
-    vertices.push_back(centerX);
-    vertices.push_back(centerY);
+    // Chord error of an n-gon is r * (1 - cos(pi / n)); solve for the n that meets the tolerance.
+    if (radiusPx <= kCircleTolerancePx) return kCircleLodSegments[0];
+    double needed = 3.14159265358979 / std::acos(1.0 - kCircleTolerancePx / radiusPx);
+    return kCircleLodSegments[circleLodFor(static_cast<int>(std::ceil(needed)))];
+}
 
-    const float twoPi = 6.28318530718f;
-    for (int i = 0; i <= segments; ++i)
+void Renderer2D::drawCircle(float cx, float cy, float radius, const Color& color, int segments) const
+{
+    if (m_queue)
     {
-        float angle = twoPi * static_cast<float>(i) / static_cast<float>(segments);
-        float px = cx + std::cos(angle) * radius;
-        float py = cy + std::sin(angle) * radius;
+        m_queue->circle(cx, cy, radius, color, segments);
+        return;
+    }
 
-        float ndcX = 2.0f * px / m_windowWidth - 1.0f;
-        float ndcY = 1.0f - 2.0f * py / m_windowHeight;
+    const std::vector<float>& unit = unitCircle(circleLodFor(segments > 0 ? segments : circleSegmentsFor(radius)));
 
-        vertices.push_back(ndcX);
-        vertices.push_back(ndcY);
+    // A circle is convex, so a fan over the rim alone is enough: no center vertex.
+    m_scratch.resize(unit.size());
+    for (size_t i = 0; i < unit.size(); i += 2)
+    {
+        float px = cx + unit[i] * radius;
+        float py = cy + unit[i + 1] * radius;
+        m_scratch[i] = 2.0f * px / m_windowWidth - 1.0f;
+        m_scratch[i + 1] = 1.0f - 2.0f * py / m_windowHeight;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+    glState().bindArrayBuffer(m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_scratch.size() * sizeof(float)), m_scratch.data(), GL_DYNAMIC_DRAW);
 
-    glUseProgram(m_program);
-    glUniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, static_cast<GLsizei>(vertices.size() / 2));
-    glBindVertexArray(0);
+    useProgram();
+    glState().uniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
+    glState().bindVertexArray(m_vao);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, static_cast<GLsizei>(m_scratch.size() / 2));
 }
 
 void Renderer2D::drawFrame(const RectShape& rect, float thickness) const
@@ -118,6 +174,12 @@ void Renderer2D::drawFrame(const RectShape& rect, float thickness) const
 
 void Renderer2D::drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color) const
 {
+    if (m_queue)
+    {
+        m_queue->triangle(x1, y1, x2, y2, x3, y3, color);
+        return;
+    }
+
     float vertices[6];
     auto toNdc = [&](float x, float y)
     {
@@ -134,12 +196,71 @@ void Renderer2D::drawTriangle(float x1, float y1, float x2, float y2, float x3,
     vertices[2] = p2.first; vertices[3] = p2.second;
     vertices[4] = p3.first; vertices[5] = p3.second;
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glState().bindArrayBuffer(m_vbo);
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
-    glUseProgram(m_program);
-    glUniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
-    glBindVertexArray(m_vao);
+    useProgram();
+    glState().uniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
+    glState().bindVertexArray(m_vao);
     glDrawArrays(GL_TRIANGLES, 0, 3);
-    glBindVertexArray(0);
+}
+
+void Renderer2D::drawLineStrips(const std::vector<float>& points, const std::vector<LineStrip>& strips) const
+{
+    if (m_queue)
+    {
+        m_queue->lineStrips(points, strips);
+        return;
+    }
+    if (points.size() < 4 || strips.empty()) return;
+
+    m_scratch.resize(points.size());
+    for (size_t i = 0; i + 1 < points.size(); i += 2)
+    {
+        m_scratch[i] = 2.0f * points[i] / m_windowWidth - 1.0f;
+        m_scratch[i + 1] = 1.0f - 2.0f * points[i + 1] / m_windowHeight;
+    }
+
+    // Keep the buffer at least one rect large; drawRect/drawTriangle only sub-update it.
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(m_scratch.size() * sizeof(float));
+    GLsizeiptr minBytes = static_cast<GLsizeiptr>(12 * sizeof(float));
+    glState().bindArrayBuffer(m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, bytes > minBytes ? bytes : minBytes, nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_scratch.data());
+
+    useProgram();
+    glState().bindVertexArray(m_vao);
+    for (const LineStrip& strip : strips)
+    {
+        if (strip.count < 2) continue;
+        glState().uniform4f(m_uColorLocation, strip.color.r, strip.color.g, strip.color.b, strip.color.a);
+        glDrawArrays(GL_LINE_STRIP, strip.first, strip.count);
+    }
+}
+
+void Renderer2D::drawRects(const std::vector<float>& rects, const Color& color) const
+{
+    if (m_queue)
+    {
+        m_queue->rects(rects, color);
+        return;
+    }
+
+    size_t count = rects.size() / 4;
+    if (count == 0) return;
+
+    m_scratch.resize(count * 12);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float* r = &rects[i * 4];
+        fillRectVertices(r[0], r[1], r[2], r[3], m_windowWidth, m_windowHeight, &m_scratch[i * 12]);
+    }
+
+    glState().bindArrayBuffer(m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_scratch.size() * sizeof(float)), m_scratch.data(), GL_DYNAMIC_DRAW);
+
+    useProgram();
+    glState().uniform4f(m_uColorLocation, color.r, color.g, color.b, color.a);
+    glState().bindVertexArray(m_vao);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count * 6));
 }
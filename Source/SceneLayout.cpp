@@ -0,0 +1,81 @@
+#include "../Header/SceneLayout.h"
+
+#include <algorithm>
+
+namespace
+{
+    RectShape shifted(const RectShape& r, float dx, float dy)
+    {
+        RectShape out = r;
+        out.x += dx;
+        out.y += dy;
+        return out;
+    }
+
+    CircleShape shifted(const CircleShape& c, float dx, float dy)
+    {
+        CircleShape out = c;
+        out.x += dx;
+        out.y += dy;
+        return out;
+    }
+}
+
+SceneShapes makeUnitShapes()
+{
+    SceneShapes shapes;
+    shapes.body = RectShape{ 0.0f, 0.0f, kUnitBodyW, kUnitBodyH, kUnitBodyColor };
+    shapes.vent = RectShape{ kUnitVentX, kUnitVentY, kUnitVentW, kUnitVentClosedH, kUnitVentColor };
+    shapes.lamp = CircleShape{ kUnitLampX, kUnitLampY, kUnitLampR, kUnitLampOffColor };
+    for (size_t i = 0; i < shapes.screens.size(); ++i)
+    {
+        shapes.screens[i] = RectShape{ kUnitScreenX + static_cast<float>(i) * kUnitScreenStep, kUnitScreenY, kUnitScreenW, kUnitScreenH, kUnitScreenOffColor };
+    }
+    shapes.tempArrow = RectShape{ kUnitArrowX, kUnitScreenY, kUnitArrowW, kUnitScreenH, kUnitArrowBg };
+    shapes.bowl = RectShape{ kUnitBowlX, kUnitBowlY, kUnitBowlW, kUnitBowlH, kUnitBowlColor };
+    shapes.bowlThickness = kUnitBowlThickness;
+    return shapes;
+}
+
+SceneLayout::SceneLayout(const SceneShapes& scene)
+    : m_scene(scene)
+    , m_placed(scene)
+{
+    // The scene bounds never change, only where they land on screen.
+    const SceneShapes& s = m_scene;
+    m_minX = std::min({ s.body.x, s.tempArrow.x, s.bowl.x, s.graph.x });
+    m_minY = std::min({ s.body.y, s.tempArrow.y, s.bowl.y, s.graph.y });
+    float maxX = std::max({ s.body.x + s.body.w, s.tempArrow.x + s.tempArrow.w, s.bowl.x + s.bowl.w, s.graph.x + s.graph.w });
+    float maxY = std::max({ s.body.y + s.body.h, s.tempArrow.y + s.tempArrow.h, s.bowl.y + s.bowl.h, s.graph.y + s.graph.h });
+    m_width = maxX - m_minX;
+    m_height = maxY - m_minY;
+}
+
+void SceneLayout::resize(int framebufferWidth, int framebufferHeight)
+{
+    float dx = (static_cast<float>(framebufferWidth) - m_width) * 0.5f - m_minX;
+    float dy = (static_cast<float>(framebufferHeight) - m_height) * 0.5f - m_minY;
+
+    m_placed.body = shifted(m_scene.body, dx, dy);
+    m_placed.vent = shifted(m_scene.vent, dx, dy);
+    m_placed.lamp = shifted(m_scene.lamp, dx, dy);
+    for (size_t i = 0; i < m_scene.screens.size(); ++i)
+    {
+        m_placed.screens[i] = shifted(m_scene.screens[i], dx, dy);
+    }
+    m_placed.tempArrow = shifted(m_scene.tempArrow, dx, dy);
+    m_placed.bowl = shifted(m_scene.bowl, dx, dy);
+    m_placed.graph = shifted(m_scene.graph, dx, dy);
+
+    const RectShape& arrow = m_placed.tempArrow;
+    m_arrowUp = RectShape{ arrow.x, arrow.y, arrow.w, arrow.h * 0.5f, arrow.color };
+    m_arrowDown = RectShape{ arrow.x, arrow.y + arrow.h * 0.5f, arrow.w, arrow.h * 0.5f, arrow.color };
+
+    float t = m_scene.bowlThickness;
+    const RectShape& bowl = m_placed.bowl;
+    m_bowlInner = RectShape{ bowl.x + t, bowl.y + t, bowl.w - 2.0f * t, bowl.h - 2.0f * t, bowl.color };
+
+    m_hitGrid.setRect(CONTROL_TEMP_UP, m_arrowUp);
+    m_hitGrid.setRect(CONTROL_TEMP_DOWN, m_arrowDown);
+    m_hitGrid.setCircle(CONTROL_POWER, m_placed.lamp);
+}
@@ -0,0 +1,164 @@
+#include "../Header/ShaderCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    const char kMagic[4] = { 'A', 'C', 'S', 'B' };
+    constexpr std::uint32_t kFileVersion = 1;
+
+    std::string g_directory = "ShaderCache";
+
+    struct CacheHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t format; // driver-specific binary format enum
+        std::uint32_t length;
+    };
+
+    bool cacheSupported()
+    {
+        if (g_directory.empty()) return false;
+        if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) return false;
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }
+
+    void hashBytes(std::uint64_t& hash, const char* data, size_t size)
+    {
+        // FNV-1a, 64-bit.
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    void hashString(std::uint64_t& hash, const char* text)
+    {
+        if (text) hashBytes(hash, text, std::char_traits<char>::length(text));
+        hashBytes(hash, "", 1); // separator, so "ab"+"c" and "a"+"bc" differ
+    }
+
+    std::string cachePath(const std::string& vertexSource, const std::string& fragmentSource)
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        hashString(hash, vertexSource.c_str());
+        hashString(hash, fragmentSource.c_str());
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(hash));
+        return g_directory + name;
+    }
+
+    void makeDirectory(const std::string& path)
+    {
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+}
+
+void setShaderCacheDirectory(const std::string& directory)
+{
+    g_directory = directory;
+}
+
+GLuint loadCachedProgram(const std::string& vertexSource, const std::string& fragmentSource)
+{
+    if (!cacheSupported()) return 0;
+
+    std::string path = cachePath(vertexSource, fragmentSource);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return 0;
+
+    CacheHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    bool valid = file && std::equal(kMagic, kMagic + 4, header.magic) && header.version == kFileVersion && header.length > 0;
+    std::vector<char> binary(valid ? header.length : 0);
+    if (valid)
+    {
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        valid = static_cast<bool>(file);
+    }
+    file.close();
+
+    if (valid)
+    {
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked == GL_TRUE) return program;
+        glDeleteProgram(program);
+    }
+
+    // Truncated, from another build of the driver, or otherwise rejected: drop it and recompile.
+    std::cout << "Kes sejdera odbijen, ponovo kompajliram: " << path << std::endl;
+    std::remove(path.c_str());
+    return 0;
+}
+
+void prepareProgramForCache(GLuint program)
+{
+    if (!cacheSupported()) return;
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void storeCachedProgram(GLuint program, const std::string& vertexSource, const std::string& fragmentSource)
+{
+    if (!cacheSupported()) return;
+
+    GLint linked = GL_FALSE;
+    GLint length = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (linked != GL_TRUE || length <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    makeDirectory(g_directory);
+    std::string path = cachePath(vertexSource, fragmentSource);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+
+        CacheHeader header{};
+        std::copy(kMagic, kMagic + 4, header.magic);
+        header.version = kFileVersion;
+        header.format = format;
+        header.length = static_cast<std::uint32_t>(written);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file) return;
+    }
+    // Write-then-rename, so a second instance never reads a half-written entry.
+    std::remove(path.c_str());
+    std::rename(temporary.c_str(), path.c_str());
+}
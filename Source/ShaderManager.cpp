@@ -0,0 +1,253 @@
+#include "../Header/ShaderManager.h"
+
+#include "../Header/GlState.h"
+#include "../Header/ShaderCache.h"
+#include "../Header/ShaderSources.h"
+#include "../Header/Trace.h"
+
+#include <iostream>
+
+namespace
+{
+    GLuint startCompile(GLenum type, const std::string& source)
+    {
+        const char* code = source.c_str();
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &code, NULL);
+        glCompileShader(shader);
+        return shader;
+    }
+
+    void reportShaderErrors(GLuint shader, const char* stage, const std::string& path)
+    {
+        GLint success = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (success == GL_TRUE) return;
+
+        char infoLog[512];
+        glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+        std::cout << stage << " sejder \"" << path << "\" ima gresku! Greska: \n" << infoLog << std::endl;
+    }
+
+    bool linked(GLuint program)
+    {
+        GLint status = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        return status == GL_TRUE;
+    }
+
+    void reportProgramErrors(GLuint program)
+    {
+        char infoLog[512];
+        glGetProgramInfoLog(program, sizeof(infoLog), NULL, infoLog);
+        std::cout << "Objedinjeni sejder ima gresku! Greska: \n" << infoLog << std::endl;
+    }
+
+    void deleteShaders(GLuint program, GLuint& vertexShader, GLuint& fragmentShader)
+    {
+        glDetachShader(program, vertexShader);
+        glDeleteShader(vertexShader);
+        glDetachShader(program, fragmentShader);
+        glDeleteShader(fragmentShader);
+        vertexShader = 0;
+        fragmentShader = 0;
+    }
+
+    std::string baseName(const std::string& path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+}
+
+ShaderManager& shaderManager()
+{
+    static ShaderManager manager;
+    return manager;
+}
+
+void ShaderManager::init()
+{
+    // 0xFFFFFFFF: implementation-chosen thread count. KHR and ARB share the enum and behavior.
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+        m_parallel = true;
+    }
+    else if (GLEW_ARB_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+        m_parallel = true;
+    }
+}
+
+ShaderManager::Handle ShaderManager::submit(const std::string& vertexPath, const std::string& fragmentPath)
+{
+    AC_TRACE_SCOPE("ShaderManager::submit");
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].vertexPath == vertexPath && m_entries[i].fragmentPath == fragmentPath) return static_cast<Handle>(i);
+    }
+
+    Entry entry;
+    entry.vertexPath = vertexPath;
+    entry.fragmentPath = fragmentPath;
+    entry.vertexSource = loadShaderSource(vertexPath);
+    entry.fragmentSource = loadShaderSource(fragmentPath);
+
+    entry.program = loadCachedProgram(entry.vertexSource, entry.fragmentSource);
+    if (entry.program == 0)
+    {
+        entry.program = glCreateProgram();
+        entry.vertexShader = startCompile(GL_VERTEX_SHADER, entry.vertexSource);
+        entry.fragmentShader = startCompile(GL_FRAGMENT_SHADER, entry.fragmentSource);
+        glAttachShader(entry.program, entry.vertexShader);
+        glAttachShader(entry.program, entry.fragmentShader);
+        prepareProgramForCache(entry.program);
+        glLinkProgram(entry.program); // returns at once; the status is read in resolve()
+    }
+    m_entries.push_back(entry);
+    return static_cast<Handle>(m_entries.size() - 1);
+}
+
+bool ShaderManager::isReady(Handle handle) const
+{
+    if (handle < 0 || handle >= static_cast<Handle>(m_entries.size())) return false;
+
+    const Entry& entry = m_entries[handle];
+    if (entry.resolved || entry.vertexShader == 0) return true;
+    if (!m_parallel) return false; // without the extension any query could block
+
+    GLint done = GL_FALSE;
+    glGetProgramiv(entry.program, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+GLuint ShaderManager::program(Handle handle)
+{
+    if (handle < 0 || handle >= static_cast<Handle>(m_entries.size())) return 0;
+
+    Entry& entry = m_entries[handle];
+    if (!entry.resolved)
+    {
+        resolve(entry);
+    }
+    return entry.program;
+}
+
+void ShaderManager::resolve(Entry& entry)
+{
+    AC_TRACE_SCOPE("ShaderManager::resolve");
+    entry.resolved = true;
+    if (entry.vertexShader == 0) return; // loaded from the cache, already linked
+
+    if (linked(entry.program))
+    {
+        storeCachedProgram(entry.program, entry.vertexSource, entry.fragmentSource);
+    }
+    else
+    {
+        reportShaderErrors(entry.vertexShader, "VERTEX", entry.vertexPath);
+        reportShaderErrors(entry.fragmentShader, "FRAGMENT", entry.fragmentPath);
+        reportProgramErrors(entry.program);
+    }
+
+    deleteShaders(entry.program, entry.vertexShader, entry.fragmentShader);
+    entry.vertexSource.clear();
+    entry.fragmentSource.clear();
+}
+
+unsigned int ShaderManager::version(Handle handle) const
+{
+    if (handle < 0 || handle >= static_cast<Handle>(m_entries.size())) return 0;
+    return m_entries[handle].version;
+}
+
+void ShaderManager::reload(const std::string& fileName)
+{
+    for (Entry& entry : m_entries)
+    {
+        if (baseName(entry.vertexPath) != fileName && baseName(entry.fragmentPath) != fileName) continue;
+
+        // A newer save supersedes a rebuild still in flight.
+        discardPending(entry);
+        std::cout << "Ponovo kompajliram sejder: " << fileName << std::endl;
+        if (!m_parallel)
+        {
+            std::cout << "Nema paralelnog kompajliranja sejdera; frejm moze da zastane dok se ne zavrsi." << std::endl;
+        }
+        entry.pendingProgram = glCreateProgram();
+        entry.pendingVertexShader = startCompile(GL_VERTEX_SHADER, loadShaderSource(entry.vertexPath));
+        entry.pendingFragmentShader = startCompile(GL_FRAGMENT_SHADER, loadShaderSource(entry.fragmentPath));
+        glAttachShader(entry.pendingProgram, entry.pendingVertexShader);
+        glAttachShader(entry.pendingProgram, entry.pendingFragmentShader);
+        glLinkProgram(entry.pendingProgram);
+        entry.pendingSeenOnce = false;
+    }
+}
+
+bool ShaderManager::update()
+{
+    bool changed = false;
+    for (Entry& entry : m_entries)
+    {
+        if (entry.pendingProgram == 0) continue;
+
+        if (m_parallel)
+        {
+            GLint done = GL_FALSE;
+            glGetProgramiv(entry.pendingProgram, GL_COMPLETION_STATUS_KHR, &done);
+            if (done != GL_TRUE) continue;
+        }
+        else if (!entry.pendingSeenOnce)
+        {
+            // No way to ask without blocking: give a threaded driver one frame to finish first.
+            entry.pendingSeenOnce = true;
+            continue;
+        }
+
+        if (!linked(entry.pendingProgram))
+        {
+            reportShaderErrors(entry.pendingVertexShader, "VERTEX", entry.vertexPath);
+            reportShaderErrors(entry.pendingFragmentShader, "FRAGMENT", entry.fragmentPath);
+            reportProgramErrors(entry.pendingProgram);
+            std::cout << "Zadrzan poslednji ispravan program." << std::endl;
+            discardPending(entry);
+            continue;
+        }
+
+        if (!entry.resolved) resolve(entry);
+        deleteShaders(entry.pendingProgram, entry.pendingVertexShader, entry.pendingFragmentShader);
+        glState().forgetProgram(entry.program);
+        glDeleteProgram(entry.program);
+        entry.program = entry.pendingProgram;
+        entry.pendingProgram = 0;
+        ++entry.version;
+        changed = true;
+    }
+    return changed;
+}
+
+void ShaderManager::discardPending(Entry& entry)
+{
+    if (entry.pendingProgram == 0) return;
+    deleteShaders(entry.pendingProgram, entry.pendingVertexShader, entry.pendingFragmentShader);
+    glDeleteProgram(entry.pendingProgram);
+    entry.pendingProgram = 0;
+}
+
+void ShaderManager::clear()
+{
+    for (Entry& entry : m_entries)
+    {
+        discardPending(entry);
+        if (entry.vertexShader != 0) glDeleteShader(entry.vertexShader);
+        if (entry.fragmentShader != 0) glDeleteShader(entry.fragmentShader);
+        if (entry.program != 0)
+        {
+            glState().forgetProgram(entry.program);
+            glDeleteProgram(entry.program);
+        }
+    }
+    m_entries.clear();
+}
@@ -0,0 +1,45 @@
+#include "../Header/ShaderSources.h"
+
+#include "../Header/EmbeddedShaders.h"
+#include "../Header/Util.h"
+
+#include <fstream>
+
+namespace
+{
+    std::string g_overrideDirectory;
+
+    std::string fileName(const std::string& path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+}
+
+void setShaderOverrideDirectory(const std::string& directory)
+{
+    g_overrideDirectory = directory;
+}
+
+const std::string& shaderOverrideDirectory()
+{
+    return g_overrideDirectory;
+}
+
+std::string loadShaderSource(const std::string& path)
+{
+    std::string name = fileName(path);
+    if (!g_overrideDirectory.empty())
+    {
+        std::string overridePath = g_overrideDirectory + "/" + name;
+        if (std::ifstream(overridePath).good()) return readShaderSource(overridePath.c_str());
+    }
+
+    for (const EmbeddedShader* shader = kEmbeddedShaders; shader->name != nullptr; ++shader)
+    {
+        if (name == shader->name) return shader->source;
+    }
+
+    // Added to Shaders/ since the last build: read it from disk as before.
+    return readShaderSource(path.c_str());
+}
@@ -0,0 +1,146 @@
+#include "../Header/ShaderWatcher.h"
+
+#include "../Header/Trace.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    bool isShaderFile(const std::string& name)
+    {
+        auto endsWith = [&name](const char* suffix)
+        {
+            std::string s(suffix);
+            return name.size() >= s.size() && name.compare(name.size() - s.size(), s.size(), s) == 0;
+        };
+        return endsWith(".vert") || endsWith(".frag");
+    }
+}
+
+ShaderWatcher::ShaderWatcher(const std::string& directory)
+    : m_directory(directory)
+{
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    m_watching = handle != INVALID_HANDLE_VALUE;
+    m_directoryHandle = m_watching ? handle : nullptr;
+#else
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_watching = m_inotify >= 0 && inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0;
+#endif
+
+    if (!m_watching)
+    {
+        std::cout << "Ne mogu da pratim direktorijum sejdera: " << directory << std::endl;
+        return;
+    }
+    m_running = true;
+    m_thread = std::thread(&ShaderWatcher::run, this);
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+    m_running = false;
+#ifdef _WIN32
+    if (m_thread.joinable()) m_thread.join();
+    if (m_directoryHandle) CloseHandle(m_directoryHandle);
+#else
+    if (m_thread.joinable()) m_thread.join();
+    if (m_inotify >= 0) close(m_inotify);
+#endif
+}
+
+bool ShaderWatcher::takeChanges(std::vector<std::string>& out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_changes.empty()) return false;
+    out.insert(out.end(), m_changes.begin(), m_changes.end());
+    m_changes.clear();
+    return true;
+}
+
+void ShaderWatcher::notify(const std::string& fileName)
+{
+    if (!isShaderFile(fileName)) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::find(m_changes.begin(), m_changes.end(), fileName) == m_changes.end())
+    {
+        m_changes.push_back(fileName);
+    }
+}
+
+void ShaderWatcher::run()
+{
+    traceSetThreadName("shader watcher");
+    alignas(8) char buffer[4096];
+
+#ifdef _WIN32
+    HANDLE directory = static_cast<HANDLE>(m_directoryHandle);
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        ResetEvent(overlapped.hEvent);
+        if (!ReadDirectoryChangesW(directory, buffer, sizeof(buffer), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, NULL, &overlapped, NULL)) break;
+
+        // Short timeout so the destructor never waits long for the thread.
+        while (m_running.load(std::memory_order_relaxed) && WaitForSingleObject(overlapped.hEvent, 200) == WAIT_TIMEOUT)
+        {
+        }
+
+        DWORD bytes = 0;
+        if (!m_running.load(std::memory_order_relaxed))
+        {
+            CancelIo(directory);
+            GetOverlappedResult(directory, &overlapped, &bytes, TRUE);
+            break;
+        }
+        if (!GetOverlappedResult(directory, &overlapped, &bytes, FALSE)) break; // the directory went away
+        if (bytes == 0) continue; // buffer overflowed; nothing to report per file
+
+        for (DWORD offset = 0;;)
+        {
+            const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+            if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+            {
+                int wideLength = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+                int length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, NULL, 0, NULL, NULL);
+                std::string name(static_cast<size_t>(length), '\0');
+                WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, &name[0], length, NULL, NULL);
+                notify(name);
+            }
+            if (info->NextEntryOffset == 0) break;
+            offset += info->NextEntryOffset;
+        }
+    }
+    CloseHandle(overlapped.hEvent);
+#else
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        // Short timeout so the destructor never waits long for the thread.
+        pollfd fd{ m_inotify, POLLIN, 0 };
+        if (poll(&fd, 1, 200) <= 0) continue;
+
+        ssize_t bytes = read(m_inotify, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < bytes;)
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0) notify(event->name);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+#endif
+}
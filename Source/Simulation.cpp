@@ -0,0 +1,217 @@
+#include "../Header/Simulation.h"
+
+#include "../Header/Trace.h"
+
+#include <chrono>
+
+namespace
+{
+    // After a long stall (debugger, suspend) resync instead of replaying every missed tick.
+    constexpr int kMaxCatchUpTicks = 250;
+
+    std::vector<std::unique_ptr<ThermostatController>> singleController(std::unique_ptr<ThermostatController> controller)
+    {
+        std::vector<std::unique_ptr<ThermostatController>> controllers;
+        controllers.push_back(std::move(controller));
+        return controllers;
+    }
+}
+
+SimulationThread::SimulationThread(TelemetryRing& telemetry, std::unique_ptr<ThermostatController> controller, double tickHz)
+    : SimulationThread(telemetry, std::vector<AppState>(1), singleController(std::move(controller)), tickHz)
+{
+}
+
+SimulationThread::SimulationThread(TelemetryRing& telemetry, std::vector<AppState> units, std::vector<std::unique_ptr<ThermostatController>> controllers, double tickHz)
+    : m_telemetry(telemetry)
+    , m_controllers(std::move(controllers))
+    , m_tickSeconds(1.0 / (tickHz > 0.0 ? tickHz : 1000.0))
+{
+    if (units.empty())
+    {
+        units.resize(1);
+    }
+    m_current.units = std::move(units);
+
+    m_controllers.resize(m_current.units.size());
+    bool allMpc = true;
+    for (auto& controller : m_controllers)
+    {
+        if (!controller)
+        {
+            controller.reset(new BangBangController());
+        }
+        allMpc = allMpc && dynamic_cast<MpcController*>(controller.get()) != nullptr;
+    }
+    if (allMpc)
+    {
+        // One solve per tick for the whole fleet instead of one per unit.
+        m_mpcBatch.reset(new MpcBatch(static_cast<MpcController&>(*m_controllers[0]).config()));
+    }
+
+    // Make the initial state visible before the first tick runs.
+    publish();
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start()
+{
+    if (m_running.exchange(true)) return;
+    m_thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+    if (!m_running.exchange(false)) return;
+    wake();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void SimulationThread::advance(int ticks)
+{
+    if (m_running.load(std::memory_order_relaxed) || ticks <= 0) return;
+
+    const float deltaTime = static_cast<float>(m_tickSeconds);
+    Clock::time_point now = Clock::now();
+    for (int i = 0; i < ticks; ++i)
+    {
+        tick(deltaTime, now);
+    }
+    publish();
+}
+
+bool SimulationThread::pushInput(InputCommand command, Clock::time_point timestamp, std::size_t unit)
+{
+    TimedInput input;
+    input.command = command;
+    input.timestamp = timestamp;
+    input.unit = unit;
+    if (!m_inputs.push(input)) return false;
+    wake();
+    return true;
+}
+
+void SimulationThread::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakePending = true;
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool SimulationThread::allAtRest() const
+{
+    if (m_hasHeldInput) return false;
+    for (const AppState& state : m_current.units)
+    {
+        if (!isAtRest(state)) return false;
+    }
+    return true;
+}
+
+void SimulationThread::tick(float deltaTime, Clock::time_point scheduledAt)
+{
+    AC_TRACE_SCOPE("sim tick");
+    std::vector<AppState>& units = m_current.units;
+
+    // Apply input that happened up to this tick's slot; later input waits for its own tick,
+    // so catch-up ticks after a stall still see events in the right order.
+    while (m_hasHeldInput || m_inputs.pop(m_heldInput))
+    {
+        m_hasHeldInput = true;
+        if (m_heldInput.timestamp > scheduledAt) break;
+        if (m_heldInput.unit < units.size())
+        {
+            applyInputCommand(units[m_heldInput.unit], m_heldInput.command);
+        }
+        m_hasHeldInput = false;
+    }
+
+    // Each step only touches its own unit, so running them step by step over all
+    // units gives the same result as running them unit by unit. It also keeps the
+    // trace to three events per tick however many units there are.
+    {
+        AC_TRACE_SCOPE("updateVent");
+        for (AppState& state : units) updateVent(state, deltaTime);
+    }
+    {
+        AC_TRACE_SCOPE("updateTemperature");
+        if (m_mpcBatch)
+        {
+            m_mpcBatch->updateTemperatures(units, deltaTime);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < units.size(); ++i) updateTemperature(units[i], deltaTime, *m_controllers[i]);
+        }
+    }
+    {
+        AC_TRACE_SCOPE("updateWater");
+        for (AppState& state : units) updateWater(state, deltaTime, false);
+    }
+
+    ++m_current.tick;
+    m_current.time += deltaTime;
+    m_telemetry.push(makeTelemetrySample(units[0], m_current.tick, m_current.time));
+}
+
+void SimulationThread::publish()
+{
+    // Copy-assigning into the back buffer reuses its storage, so this does not allocate.
+    m_snapshots.back() = m_current;
+    m_snapshots.publish();
+}
+
+void SimulationThread::run()
+{
+    traceSetThreadName("simulation");
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_tickSeconds));
+    const float deltaTime = static_cast<float>(m_tickSeconds);
+
+    Clock::time_point next = Clock::now();
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        // Fixed timestep: run every tick that has come due, then sleep until the next one.
+        Clock::time_point now = Clock::now();
+        int ran = 0;
+        while (next <= now && ran < kMaxCatchUpTicks)
+        {
+            Clock::time_point tickStart = m_profiler ? Clock::now() : Clock::time_point();
+            tick(deltaTime, next);
+            if (m_profiler)
+            {
+                m_profiler->record(ProfilePhase::Simulation, std::chrono::duration<double>(Clock::now() - tickStart).count());
+            }
+            next += period;
+            ++ran;
+        }
+        // One snapshot per batch: catch-up ticks and large dashboards copy the units only once.
+        if (ran > 0)
+        {
+            publish();
+        }
+        if (next <= now)
+        {
+            next = now + period;
+        }
+
+        if (m_idleWhenAtRest && allAtRest())
+        {
+            // Nothing can change until input arrives, so stop ticking instead of waking
+            // every period. The simulated clock pauses with it.
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCondition.wait(lock, [this] { return m_wakePending; });
+            m_wakePending = false;
+            lock.unlock();
+            next = Clock::now();
+            continue;
+        }
+
+        std::this_thread::sleep_until(next);
+    }
+}
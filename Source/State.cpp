@@ -3,6 +3,37 @@
 #include <algorithm>
 #include <cmath>
 
+namespace
+{
+    void clampDesiredTemp(AppState& state)
+    {
+        if (state.desiredTemp < -10.0f) state.desiredTemp = -10.0f;
+        if (state.desiredTemp > 40.0f) state.desiredTemp = 40.0f;
+    }
+}
+
+void applyInputCommand(AppState& state, InputCommand command)
+{
+    switch (command)
+    {
+    case InputCommand::TogglePower:
+        if (!state.lockedByFullBowl) state.isOn = !state.isOn;
+        break;
+    case InputCommand::TemperatureUp:
+        state.desiredTemp += state.tempChangeStep;
+        clampDesiredTemp(state);
+        break;
+    case InputCommand::TemperatureDown:
+        state.desiredTemp -= state.tempChangeStep;
+        clampDesiredTemp(state);
+        break;
+    case InputCommand::DrainBowl:
+        state.waterLevel = 0.0f;
+        state.lockedByFullBowl = false;
+        break;
+    }
+}
+
 void handlePowerToggle(AppState& state, double mouseX, double mouseY, bool mouseDown, const CircleShape& lamp)
 {
     // Toggle AC on lamp click; ignore if locked by full bowl.
@@ -49,8 +80,7 @@ void handleTemperatureInput(AppState& state, bool upPressed, bool downPressed)
         state.desiredTemp -= state.tempChangeStep;
     }
 
-    if (state.desiredTemp < -10.0f) state.desiredTemp = -10.0f;
-    if (state.desiredTemp > 40.0f) state.desiredTemp = 40.0f;
+    clampDesiredTemp(state);
 
     state.prevUpPressed = upPressed;
     state.prevDownPressed = downPressed;
@@ -107,3 +137,8 @@ void updateWater(AppState& state, float deltaTime, bool spacePressed)
 
     state.prevSpacePressed = spacePressed;
 }
+
+bool isAtRest(const AppState& state)
+{
+    return (!state.isOn || state.lockedByFullBowl) && state.ventOpenness <= 0.0f;
+}
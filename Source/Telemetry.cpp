@@ -0,0 +1,97 @@
+#include "../Header/Telemetry.h"
+
+TelemetrySample makeTelemetrySample(const AppState& state, std::uint64_t tick, double time)
+{
+    TelemetrySample sample;
+    sample.tick = tick;
+    sample.time = time;
+    sample.currentTemp = state.currentTemp;
+    sample.desiredTemp = state.desiredTemp;
+    sample.ventOpenness = state.ventOpenness;
+    sample.waterLevel = state.waterLevel;
+    sample.isOn = state.isOn;
+    sample.lockedByFullBowl = state.lockedByFullBowl;
+    return sample;
+}
+
+TelemetryRing::TelemetryRing(std::size_t capacity)
+{
+    std::size_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+    m_slots.reset(new Slot[rounded]);
+    m_mask = rounded - 1;
+}
+
+void TelemetryRing::push(const TelemetrySample& sample)
+{
+    // Seqlock write: odd version marks the slot busy, even version publishes it.
+    std::uint64_t seq = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[seq & m_mask];
+    slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sample = sample;
+    slot.version.store(2 * seq + 2, std::memory_order_release);
+    m_head.store(seq + 1, std::memory_order_release);
+}
+
+std::uint64_t TelemetryRing::published() const
+{
+    return m_head.load(std::memory_order_acquire);
+}
+
+bool TelemetryRing::read(std::uint64_t seq, TelemetrySample& out) const
+{
+    const Slot& slot = m_slots[seq & m_mask];
+    const std::uint64_t expected = 2 * seq + 2;
+    if (slot.version.load(std::memory_order_acquire) != expected) return false;
+
+    out = slot.sample;
+
+    // Re-check after the copy; a changed version means the producer lapped us mid-read.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.version.load(std::memory_order_relaxed) == expected;
+}
+
+TelemetryReader::TelemetryReader(const TelemetryRing& ring, bool fromLatest)
+    : m_ring(&ring)
+{
+    std::uint64_t head = ring.published();
+    if (fromLatest)
+    {
+        m_cursor = head;
+    }
+    else
+    {
+        m_cursor = head > ring.capacity() ? head - ring.capacity() : 0;
+    }
+}
+
+std::size_t TelemetryReader::poll(TelemetrySample* out, std::size_t maxCount)
+{
+    std::uint64_t head = m_ring->published();
+    std::size_t copied = 0;
+
+    while (copied < maxCount && m_cursor < head)
+    {
+        // Skip whatever the producer has already overwritten.
+        std::uint64_t oldest = head > m_ring->capacity() ? head - m_ring->capacity() : 0;
+        if (m_cursor < oldest)
+        {
+            m_dropped += oldest - m_cursor;
+            m_cursor = oldest;
+        }
+
+        if (m_ring->read(m_cursor, out[copied]))
+        {
+            ++copied;
+        }
+        else
+        {
+            ++m_dropped;
+            head = m_ring->published();
+        }
+        ++m_cursor;
+    }
+
+    return copied;
+}
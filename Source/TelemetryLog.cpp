@@ -0,0 +1,522 @@
+#include "../Header/TelemetryLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    constexpr char kMagic[4] = { 'A', 'C', 'T', 'L' };
+    constexpr std::uint32_t kVersion = 1;
+    constexpr int kColumnCount = static_cast<int>(TelemetryColumn::Count);
+
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+        void write(std::uint64_t value, int count)
+        {
+            for (int i = count - 1; i >= 0; --i)
+            {
+                m_acc = static_cast<std::uint8_t>((m_acc << 1) | ((value >> i) & 1u));
+                if (++m_bits == 8)
+                {
+                    m_out.push_back(m_acc);
+                    m_acc = 0;
+                    m_bits = 0;
+                }
+            }
+        }
+
+        void finish()
+        {
+            if (m_bits > 0)
+            {
+                m_out.push_back(static_cast<std::uint8_t>(m_acc << (8 - m_bits)));
+                m_acc = 0;
+                m_bits = 0;
+            }
+        }
+
+    private:
+        std::vector<std::uint8_t>& m_out;
+        std::uint8_t m_acc = 0;
+        int m_bits = 0;
+    };
+
+    class BitReader
+    {
+    public:
+        explicit BitReader(const std::vector<std::uint8_t>& in) : m_in(in) {}
+
+        std::uint64_t read(int count)
+        {
+            std::uint64_t value = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                std::size_t byte = m_pos >> 3;
+                std::uint64_t bit = byte < m_in.size() ? (m_in[byte] >> (7 - (m_pos & 7))) & 1u : 0u;
+                value = (value << 1) | bit;
+                ++m_pos;
+            }
+            return value;
+        }
+
+    private:
+        const std::vector<std::uint8_t>& m_in;
+        std::size_t m_pos = 0;
+    };
+
+    int leadingZeros32(std::uint32_t v)
+    {
+        int n = 0;
+        for (std::uint32_t mask = 0x80000000u; mask != 0 && (v & mask) == 0; mask >>= 1) ++n;
+        return n;
+    }
+
+    int trailingZeros32(std::uint32_t v)
+    {
+        int n = 0;
+        for (std::uint32_t mask = 1u; mask != 0 && (v & mask) == 0; mask <<= 1) ++n;
+        return n;
+    }
+
+    std::int64_t signExtend(std::uint64_t value, int bits)
+    {
+        std::uint64_t signBit = 1ull << (bits - 1);
+        return static_cast<std::int64_t>((value ^ signBit) - signBit);
+    }
+
+    bool fitsSigned(std::int64_t value, int bits)
+    {
+        std::int64_t limit = 1ll << (bits - 1);
+        return value >= -limit && value < limit;
+    }
+
+    void putU32(std::vector<std::uint8_t>& out, std::uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    bool getU32(std::istream& in, std::uint32_t& v)
+    {
+        unsigned char bytes[4];
+        if (!in.read(reinterpret_cast<char*>(bytes), 4)) return false;
+        v = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+        return true;
+    }
+
+    std::uint32_t floatBits(float f)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    float bitsToFloat(std::uint32_t bits)
+    {
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    // Delta-of-delta timestamps (Gorilla): most ticks are evenly spaced and cost one bit.
+    void encodeTimes(const std::vector<TelemetrySample>& rows, std::vector<std::uint8_t>& out)
+    {
+        BitWriter bits(out);
+        std::int64_t prev = 0;
+        std::int64_t prevDelta = 0;
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+            std::int64_t micros = static_cast<std::int64_t>(std::llround(rows[i].time * 1.0e6));
+            if (i == 0)
+            {
+                bits.write(static_cast<std::uint64_t>(micros), 64);
+            }
+            else
+            {
+                std::int64_t delta = micros - prev;
+                std::int64_t dod = delta - prevDelta;
+                if (dod == 0) bits.write(0x0, 1);
+                else if (fitsSigned(dod, 7)) { bits.write(0x2, 2); bits.write(static_cast<std::uint64_t>(dod), 7); }
+                else if (fitsSigned(dod, 9)) { bits.write(0x6, 3); bits.write(static_cast<std::uint64_t>(dod), 9); }
+                else if (fitsSigned(dod, 12)) { bits.write(0xE, 4); bits.write(static_cast<std::uint64_t>(dod), 12); }
+                else { bits.write(0xF, 4); bits.write(static_cast<std::uint64_t>(dod), 64); }
+                prevDelta = delta;
+            }
+            prev = micros;
+        }
+        bits.finish();
+    }
+
+    void decodeTimes(const std::vector<std::uint8_t>& in, std::uint32_t rows, std::vector<double>& out)
+    {
+        BitReader bits(in);
+        std::int64_t prev = 0;
+        std::int64_t prevDelta = 0;
+        for (std::uint32_t i = 0; i < rows; ++i)
+        {
+            std::int64_t micros;
+            if (i == 0)
+            {
+                micros = static_cast<std::int64_t>(bits.read(64));
+            }
+            else
+            {
+                std::int64_t dod = 0;
+                if (bits.read(1) != 0)
+                {
+                    if (bits.read(1) == 0) dod = signExtend(bits.read(7), 7);
+                    else if (bits.read(1) == 0) dod = signExtend(bits.read(9), 9);
+                    else if (bits.read(1) == 0) dod = signExtend(bits.read(12), 12);
+                    else dod = static_cast<std::int64_t>(bits.read(64));
+                }
+                prevDelta += dod;
+                micros = prev + prevDelta;
+            }
+            out.push_back(static_cast<double>(micros) * 1.0e-6);
+            prev = micros;
+        }
+    }
+
+    float columnValue(const TelemetrySample& row, TelemetryColumn column)
+    {
+        switch (column)
+        {
+        case TelemetryColumn::CurrentTemp: return row.currentTemp;
+        case TelemetryColumn::DesiredTemp: return row.desiredTemp;
+        case TelemetryColumn::VentOpenness: return row.ventOpenness;
+        case TelemetryColumn::WaterLevel: return row.waterLevel;
+        default: return 0.0f;
+        }
+    }
+
+    // Gorilla XOR compression: repeated values cost one bit, slow drifts only their changed mantissa bits.
+    void encodeFloats(const std::vector<TelemetrySample>& rows, TelemetryColumn column, std::vector<std::uint8_t>& out)
+    {
+        BitWriter bits(out);
+        std::uint32_t prev = 0;
+        int prevLead = -1;
+        int prevTrail = 0;
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+            std::uint32_t value = floatBits(columnValue(rows[i], column));
+            if (i == 0)
+            {
+                bits.write(value, 32);
+                prev = value;
+                continue;
+            }
+
+            std::uint32_t x = value ^ prev;
+            prev = value;
+            if (x == 0)
+            {
+                bits.write(0, 1);
+                continue;
+            }
+
+            bits.write(1, 1);
+            int lead = std::min(leadingZeros32(x), 31);
+            int trail = trailingZeros32(x);
+            if (prevLead >= 0 && lead >= prevLead && trail >= prevTrail)
+            {
+                // Meaningful bits fit inside the previous window.
+                bits.write(0, 1);
+                bits.write(x >> prevTrail, 32 - prevLead - prevTrail);
+            }
+            else
+            {
+                int length = 32 - lead - trail;
+                bits.write(1, 1);
+                bits.write(static_cast<std::uint64_t>(lead), 5);
+                bits.write(static_cast<std::uint64_t>(length - 1), 5);
+                bits.write(x >> trail, length);
+                prevLead = lead;
+                prevTrail = trail;
+            }
+        }
+        bits.finish();
+    }
+
+    void decodeFloats(const std::vector<std::uint8_t>& in, std::uint32_t rows, std::vector<float>& out)
+    {
+        BitReader bits(in);
+        std::uint32_t prev = 0;
+        int prevLead = 0;
+        int prevTrail = 0;
+        for (std::uint32_t i = 0; i < rows; ++i)
+        {
+            if (i == 0)
+            {
+                prev = static_cast<std::uint32_t>(bits.read(32));
+            }
+            else if (bits.read(1) != 0)
+            {
+                if (bits.read(1) != 0)
+                {
+                    prevLead = static_cast<int>(bits.read(5));
+                    int length = static_cast<int>(bits.read(5)) + 1;
+                    prevTrail = 32 - prevLead - length;
+                }
+                int length = 32 - prevLead - prevTrail;
+                prev ^= static_cast<std::uint32_t>(bits.read(length)) << prevTrail;
+            }
+            out.push_back(bitsToFloat(prev));
+        }
+    }
+
+    bool flagValue(const TelemetrySample& row, TelemetryColumn column)
+    {
+        return column == TelemetryColumn::IsOn ? row.isOn : row.lockedByFullBowl;
+    }
+
+    void putVarint(std::vector<std::uint8_t>& out, std::uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.push_back(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    // Run-length flags: first value byte, then alternating run lengths as varints.
+    void encodeFlags(const std::vector<TelemetrySample>& rows, TelemetryColumn column, std::vector<std::uint8_t>& out)
+    {
+        if (rows.empty()) return;
+        bool current = flagValue(rows[0], column);
+        out.push_back(current ? 1 : 0);
+
+        std::uint32_t run = 0;
+        for (const TelemetrySample& row : rows)
+        {
+            bool value = flagValue(row, column);
+            if (value != current)
+            {
+                putVarint(out, run);
+                current = value;
+                run = 0;
+            }
+            ++run;
+        }
+        putVarint(out, run);
+    }
+
+    void decodeFlags(const std::vector<std::uint8_t>& in, std::uint32_t rows, std::vector<std::uint8_t>& out)
+    {
+        if (in.empty()) return;
+        std::uint8_t value = in[0] ? 1 : 0;
+        std::size_t pos = 1;
+        std::uint32_t produced = 0;
+        while (produced < rows && pos < in.size())
+        {
+            std::uint32_t run = 0;
+            int shift = 0;
+            while (pos < in.size())
+            {
+                std::uint8_t byte = in[pos++];
+                run |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+                shift += 7;
+                if ((byte & 0x80) == 0) break;
+            }
+            run = std::min(run, rows - produced);
+            out.insert(out.end(), run, value);
+            produced += run;
+            value ^= 1;
+        }
+    }
+}
+
+TelemetryLogWriter::TelemetryLogWriter(std::size_t rowsPerBlock)
+    : m_rowsPerBlock(rowsPerBlock > 0 ? rowsPerBlock : 1)
+{
+    m_pending.reserve(m_rowsPerBlock);
+}
+
+TelemetryLogWriter::~TelemetryLogWriter()
+{
+    close();
+}
+
+bool TelemetryLogWriter::open(const std::string& path)
+{
+    close();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        std::cout << "Failed to open telemetry log: " << path << "\n";
+        return false;
+    }
+
+    std::vector<std::uint8_t> header(kMagic, kMagic + 4);
+    putU32(header, kVersion);
+    putU32(header, static_cast<std::uint32_t>(kColumnCount));
+    m_file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    return m_file.good();
+}
+
+void TelemetryLogWriter::append(const TelemetrySample& sample)
+{
+    if (!m_file.is_open()) return;
+
+    m_pending.push_back(sample);
+    if (m_pending.size() >= m_rowsPerBlock)
+    {
+        flush();
+    }
+}
+
+bool TelemetryLogWriter::flush()
+{
+    if (!m_file.is_open() || m_pending.empty()) return m_file.good();
+
+    for (auto& column : m_columns) column.clear();
+    encodeTimes(m_pending, m_columns[static_cast<int>(TelemetryColumn::Time)]);
+    for (TelemetryColumn c : { TelemetryColumn::CurrentTemp, TelemetryColumn::DesiredTemp, TelemetryColumn::VentOpenness, TelemetryColumn::WaterLevel })
+    {
+        encodeFloats(m_pending, c, m_columns[static_cast<int>(c)]);
+    }
+    for (TelemetryColumn c : { TelemetryColumn::IsOn, TelemetryColumn::LockedByFullBowl })
+    {
+        encodeFlags(m_pending, c, m_columns[static_cast<int>(c)]);
+    }
+
+    std::vector<std::uint8_t> blockHeader;
+    putU32(blockHeader, static_cast<std::uint32_t>(m_pending.size()));
+    for (const auto& column : m_columns) putU32(blockHeader, static_cast<std::uint32_t>(column.size()));
+    m_file.write(reinterpret_cast<const char*>(blockHeader.data()), static_cast<std::streamsize>(blockHeader.size()));
+    for (const auto& column : m_columns)
+    {
+        m_file.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size()));
+    }
+
+    m_pending.clear();
+    m_file.flush();
+    return m_file.good();
+}
+
+void TelemetryLogWriter::close()
+{
+    if (!m_file.is_open()) return;
+    flush();
+    m_file.close();
+}
+
+bool TelemetryLogReader::open(const std::string& path)
+{
+    m_file.close();
+    m_file.clear();
+    m_file.open(path, std::ios::binary);
+    if (!m_file.is_open())
+    {
+        std::cout << "Failed to open telemetry log: " << path << "\n";
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    if (!m_file.read(magic, 4) || std::memcmp(magic, kMagic, 4) != 0 || !getU32(m_file, version) || version != kVersion || !getU32(m_file, m_columnCount))
+    {
+        std::cout << "Not a telemetry log: " << path << "\n";
+        m_file.close();
+        return false;
+    }
+
+    m_firstBlock = static_cast<std::streamoff>(m_file.tellg());
+    return true;
+}
+
+bool TelemetryLogReader::readColumnBlocks(TelemetryColumn column, const std::function<bool(const std::vector<std::uint8_t>& bytes, std::uint32_t rows)>& onBlock)
+{
+    std::uint32_t index = static_cast<std::uint32_t>(column);
+    if (!m_file.is_open() || index >= m_columnCount) return false;
+
+    m_file.clear();
+    m_file.seekg(m_firstBlock);
+
+    std::vector<std::uint32_t> lengths(m_columnCount);
+    std::vector<std::uint8_t> bytes;
+    std::uint32_t rows = 0;
+    while (getU32(m_file, rows))
+    {
+        for (auto& length : lengths)
+        {
+            if (!getU32(m_file, length)) return false;
+        }
+
+        // Seek over the columns before and after the one we decode.
+        std::streamoff skipBefore = 0;
+        std::streamoff skipAfter = 0;
+        for (std::uint32_t c = 0; c < m_columnCount; ++c)
+        {
+            if (c < index) skipBefore += lengths[c];
+            else if (c > index) skipAfter += lengths[c];
+        }
+
+        m_file.seekg(skipBefore, std::ios::cur);
+        bytes.resize(lengths[index]);
+        if (!bytes.empty() && !m_file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) return false;
+        m_file.seekg(skipAfter, std::ios::cur);
+
+        if (!onBlock(bytes, rows)) return false;
+    }
+    return true;
+}
+
+bool TelemetryLogReader::readTimes(const std::function<void(const double* values, std::size_t count)>& onBlock)
+{
+    std::vector<double> decoded;
+    return readColumnBlocks(TelemetryColumn::Time, [&](const std::vector<std::uint8_t>& bytes, std::uint32_t rows)
+    {
+        decoded.clear();
+        decodeTimes(bytes, rows, decoded);
+        onBlock(decoded.data(), decoded.size());
+        return true;
+    });
+}
+
+bool TelemetryLogReader::readFloats(TelemetryColumn column, const std::function<void(const float* values, std::size_t count)>& onBlock)
+{
+    if (column < TelemetryColumn::CurrentTemp || column > TelemetryColumn::WaterLevel) return false;
+
+    std::vector<float> decoded;
+    return readColumnBlocks(column, [&](const std::vector<std::uint8_t>& bytes, std::uint32_t rows)
+    {
+        decoded.clear();
+        decodeFloats(bytes, rows, decoded);
+        onBlock(decoded.data(), decoded.size());
+        return true;
+    });
+}
+
+bool TelemetryLogReader::readFlags(TelemetryColumn column, const std::function<void(const std::uint8_t* values, std::size_t count)>& onBlock)
+{
+    if (column != TelemetryColumn::IsOn && column != TelemetryColumn::LockedByFullBowl) return false;
+
+    std::vector<std::uint8_t> decoded;
+    return readColumnBlocks(column, [&](const std::vector<std::uint8_t>& bytes, std::uint32_t rows)
+    {
+        decoded.clear();
+        decodeFlags(bytes, rows, decoded);
+        onBlock(decoded.data(), decoded.size());
+        return true;
+    });
+}
+
+bool TelemetryLogReader::readTimes(std::vector<double>& out)
+{
+    return readTimes([&](const double* values, std::size_t count) { out.insert(out.end(), values, values + count); });
+}
+
+bool TelemetryLogReader::readFloats(TelemetryColumn column, std::vector<float>& out)
+{
+    return readFloats(column, [&](const float* values, std::size_t count) { out.insert(out.end(), values, values + count); });
+}
+
+bool TelemetryLogReader::readFlags(TelemetryColumn column, std::vector<std::uint8_t>& out)
+{
+    return readFlags(column, [&](const std::uint8_t* values, std::size_t count) { out.insert(out.end(), values, values + count); });
+}
@@ -0,0 +1,144 @@
+#include "../Header/TemperatureGraph.h"
+
+#include <algorithm>
+#include <cmath>
+
+TemperatureGraph::TemperatureGraph(const TelemetryRing& ring, double windowSeconds)
+    : m_reader(ring)
+    , m_windowSeconds(windowSeconds > 0.0 ? windowSeconds : 1.0)
+{
+    m_incoming.resize(1024);
+    setColumns(360);
+}
+
+void TemperatureGraph::setWindowSeconds(double seconds)
+{
+    if (seconds <= 0.0 || seconds == m_windowSeconds) return;
+    m_windowSeconds = seconds;
+    setColumns(m_columns);
+}
+
+void TemperatureGraph::setColumns(int columns)
+{
+    // Buckets only hold decimated data, so a new resolution starts from an empty plot.
+    m_columns = std::max(columns, 1);
+    m_columnSeconds = m_windowSeconds / static_cast<double>(m_columns);
+    m_buckets.assign(static_cast<size_t>(m_columns), Bucket{});
+}
+
+bool TemperatureGraph::addSample(const TelemetrySample& sample)
+{
+    m_latestTime = std::max(m_latestTime, sample.time);
+    if (m_buckets.empty()) return false;
+
+    std::int64_t index = static_cast<std::int64_t>(std::floor(sample.time / m_columnSeconds));
+    Bucket& bucket = m_buckets[static_cast<size_t>(index % m_columns)];
+    if (bucket.index != index)
+    {
+        bucket.index = index;
+        bucket.currentMin = bucket.currentMax = sample.currentTemp;
+        bucket.desiredMin = bucket.desiredMax = sample.desiredTemp;
+        return true;
+    }
+
+    if (sample.currentTemp >= bucket.currentMin && sample.currentTemp <= bucket.currentMax
+        && sample.desiredTemp >= bucket.desiredMin && sample.desiredTemp <= bucket.desiredMax)
+    {
+        return false;
+    }
+
+    bucket.currentMin = std::min(bucket.currentMin, sample.currentTemp);
+    bucket.currentMax = std::max(bucket.currentMax, sample.currentTemp);
+    bucket.desiredMin = std::min(bucket.desiredMin, sample.desiredTemp);
+    bucket.desiredMax = std::max(bucket.desiredMax, sample.desiredTemp);
+    return true;
+}
+
+bool TemperatureGraph::update()
+{
+    bool changed = false;
+    std::size_t count;
+    while ((count = m_reader.poll(m_incoming.data(), m_incoming.size())) > 0)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            changed |= addSample(m_incoming[i]);
+        }
+    }
+    return changed;
+}
+
+void TemperatureGraph::appendSeries(const RectShape& area, std::int64_t firstIndex, bool desired, float minTemp, float maxTemp, const Color& color)
+{
+    float span = maxTemp - minTemp;
+    auto toY = [&](float temp)
+    {
+        return area.y + area.h - (temp - minTemp) / span * area.h;
+    };
+
+    LineStrip strip{ static_cast<int>(m_points.size() / 2), 0, color };
+    for (int column = 0; column < m_columns; ++column)
+    {
+        std::int64_t index = firstIndex + column;
+        const Bucket& bucket = m_buckets[static_cast<size_t>(index % m_columns)];
+        if (bucket.index != index)
+        {
+            // Gap in the history: close the current strip and start a new one.
+            if (strip.count > 0) m_strips.push_back(strip);
+            strip = LineStrip{ static_cast<int>(m_points.size() / 2), 0, color };
+            continue;
+        }
+
+        float x = area.x + static_cast<float>(column) + 0.5f;
+        float lo = desired ? bucket.desiredMin : bucket.currentMin;
+        float hi = desired ? bucket.desiredMax : bucket.currentMax;
+        m_points.push_back(x);
+        m_points.push_back(toY(lo));
+        m_points.push_back(x);
+        m_points.push_back(toY(hi));
+        strip.count += 2;
+    }
+    if (strip.count > 0) m_strips.push_back(strip);
+}
+
+void TemperatureGraph::draw(Renderer2D& renderer, const RectShape& area, const Color& currentColor, const Color& desiredColor)
+{
+    int columns = static_cast<int>(area.w);
+    if (columns <= 1 || area.h <= 1.0f) return;
+    if (columns != m_columns)
+    {
+        setColumns(columns);
+    }
+
+    renderer.drawRect(area.x, area.y, area.w, area.h, area.color);
+
+    std::int64_t lastIndex = static_cast<std::int64_t>(std::floor(m_latestTime / m_columnSeconds));
+    std::int64_t firstIndex = std::max<std::int64_t>(lastIndex - m_columns + 1, 0);
+
+    // Fit the vertical range to what is visible, with a little headroom.
+    float minTemp = 0.0f;
+    float maxTemp = 0.0f;
+    bool any = false;
+    for (int column = 0; column < m_columns; ++column)
+    {
+        const Bucket& bucket = m_buckets[static_cast<size_t>((firstIndex + column) % m_columns)];
+        if (bucket.index != firstIndex + column) continue;
+        float lo = std::min(bucket.currentMin, bucket.desiredMin);
+        float hi = std::max(bucket.currentMax, bucket.desiredMax);
+        minTemp = any ? std::min(minTemp, lo) : lo;
+        maxTemp = any ? std::max(maxTemp, hi) : hi;
+        any = true;
+    }
+    if (!any) return;
+
+    float center = (minTemp + maxTemp) * 0.5f;
+    float half = std::max((maxTemp - minTemp) * 0.5f * 1.1f, 1.0f);
+    minTemp = center - half;
+    maxTemp = center + half;
+
+    m_points.clear();
+    m_strips.clear();
+    appendSeries(area, firstIndex, true, minTemp, maxTemp, desiredColor);
+    appendSeries(area, firstIndex, false, minTemp, maxTemp, currentColor);
+    renderer.drawLineStrips(m_points, m_strips);
+}
@@ -1,5 +1,7 @@
 #include "../Header/TemperatureUI.h"
 
+#include "../Header/Controller.h"
+
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
@@ -143,7 +145,7 @@ void drawStatusIcon(Renderer2D& renderer, const RectShape& screen, float desired
     float cy = screen.y + screen.h * 0.5f;
     float size = std::min(screen.w, screen.h) * 0.35f;
 
-    const float tolerance = 0.25f;
+    const float tolerance = kTemperatureTolerance;
     float diff = desired - current;
 
     Color heatOuter{ 0.96f, 0.46f, 0.28f, 1.0f };
@@ -1,5 +1,8 @@
 #include "../Header/TextRenderer.h"
 
+#include "../Header/GlState.h"
+#include "../Header/RenderQueue.h"
+#include "../Header/Trace.h"
 #include "../Header/Util.h"
 
 #include <ft2build.h>
@@ -20,23 +23,19 @@ TextRenderer::TextRenderer(int windowWidth, int windowHeight)
     , m_windowHeight(static_cast<float>(windowHeight))
 {
     m_fontPath = kDefaultFontPath;
-    m_program = createShader(kTextVertexShader, kTextFragmentShader);
-    m_uTextColor = glGetUniformLocation(m_program, "uTextColor");
-    m_uWindowSize = glGetUniformLocation(m_program, "uWindowSize");
-    m_uTexture = glGetUniformLocation(m_program, "uTexture");
+    m_shader = shaderManager().submit(kTextVertexShader, kTextFragmentShader);
 
     glGenVertexArrays(1, &m_vao);
     glGenBuffers(1, &m_vbo);
 
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glState().bindVertexArray(m_vao);
+    glState().bindArrayBuffer(m_vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glBindVertexArray(0);
 
     // Attempt to load a default Windows font so the UI is usable out of the box.
     loadFont(kDefaultFontPath, 48);
@@ -53,11 +52,24 @@ void TextRenderer::cleanup()
 
     if (m_vbo != 0) glDeleteBuffers(1, &m_vbo);
     if (m_vao != 0) glDeleteVertexArrays(1, &m_vao);
-    if (m_program != 0) glDeleteProgram(m_program);
 
     m_vbo = 0;
     m_vao = 0;
-    m_program = 0;
+    glState().invalidate();
+}
+
+void TextRenderer::useProgram()
+{
+    GLuint program = shaderManager().program(m_shader);
+    unsigned int version = shaderManager().version(m_shader);
+    if (version != m_shaderVersion)
+    {
+        m_shaderVersion = version;
+        m_uTextColor = glGetUniformLocation(program, "uTextColor");
+        m_uWindowSize = glGetUniformLocation(program, "uWindowSize");
+        m_uTexture = glGetUniformLocation(program, "uTexture");
+    }
+    glState().useProgram(program);
 }
 
 void TextRenderer::destroyGlyphTextures()
@@ -66,6 +78,7 @@ void TextRenderer::destroyGlyphTextures()
     {
         if (kv.second.texture != 0)
         {
+            glState().forgetTexture(kv.second.texture);
             glDeleteTextures(1, &kv.second.texture);
         }
     }
@@ -74,6 +87,7 @@ void TextRenderer::destroyGlyphTextures()
 
 bool TextRenderer::loadFont(const std::string& fontPath, unsigned int pixelHeight)
 {
+    AC_TRACE_SCOPE("TextRenderer::loadFont");
     FT_Library ft;
     if (FT_Init_FreeType(&ft))
     {
@@ -95,9 +109,10 @@ bool TextRenderer::loadFont(const std::string& fontPath, unsigned int pixelHeigh
 
     destroyGlyphTextures();
     m_fontPixelHeight = pixelHeight;
+    glState().activeTexture(GL_TEXTURE0);
 
-    const std::string charset = " -0123456789CFPSfpsdtm."; // glyphs we preload up front
-    for (char c : charset)
+    // Preload printable ASCII so status and profiler text render without gaps.
+    for (char c = ' '; c <= '~'; ++c)
     {
         if (FT_Load_Char(face, c, FT_LOAD_RENDER))
         {
@@ -107,7 +122,7 @@ bool TextRenderer::loadFont(const std::string& fontPath, unsigned int pixelHeigh
 
         GLuint texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        glState().bindTexture2D(texture);
         glTexImage2D(
             GL_TEXTURE_2D,
             0,
@@ -136,7 +151,6 @@ bool TextRenderer::loadFont(const std::string& fontPath, unsigned int pixelHeigh
         m_glyphs[c] = glyph;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
@@ -182,18 +196,25 @@ TextMetrics TextRenderer::measure(const std::string& text, float scale) const
 
 void TextRenderer::drawText(const std::string& text, float x, float y, float scale, const Color& color)
 {
+    if (m_queue)
+    {
+        m_queue->text(text, x, y, scale, color);
+        return;
+    }
+
+    AC_TRACE_SCOPE("TextRenderer::drawText");
     if (m_glyphs.empty()) return;
 
     TextMetrics m = measure(text, scale);
     float baselineY = y + m.ascent;
 
-    glUseProgram(m_program);
-    glUniform4f(m_uTextColor, color.r, color.g, color.b, color.a);
-    glUniform2f(m_uWindowSize, m_windowWidth, m_windowHeight);
-    glUniform1i(m_uTexture, 0);
+    useProgram();
+    glState().uniform4f(m_uTextColor, color.r, color.g, color.b, color.a);
+    glState().uniform2f(m_uWindowSize, m_windowWidth, m_windowHeight);
+    glState().uniform1i(m_uTexture, 0);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(m_vao);
+    glState().activeTexture(GL_TEXTURE0);
+    glState().bindVertexArray(m_vao);
 
     float cursorX = x;
     for (char c : text)
@@ -218,20 +239,18 @@ void TextRenderer::drawText(const std::string& text, float x, float y, float sca
             { xpos + w, ypos + h, 1.0f, 0.0f }
         };
 
-        glBindTexture(GL_TEXTURE_2D, g.texture);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glState().bindTexture2D(g.texture);
+        glState().bindArrayBuffer(m_vbo);
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
         cursorX += (g.advance >> 6) * scale;
     }
-
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 bool TextRenderer::createTextTexture(const std::string& text, const Color& textColor, const Color& bgColor, unsigned int padding, unsigned int pixelHeight, GLuint& outTexture, int& outWidth, int& outHeight)
 {
+    AC_TRACE_SCOPE("TextRenderer::createTextTexture");
     auto decodeUtf8 = [](const std::string& s)
     {
         std::vector<uint32_t> codepoints;
@@ -390,13 +409,13 @@ bool TextRenderer::createTextTexture(const std::string& text, const Color& textC
     }
 
     glGenTextures(1, &outTexture);
-    glBindTexture(GL_TEXTURE_2D, outTexture);
+    glState().activeTexture(GL_TEXTURE0);
+    glState().bindTexture2D(outTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(GL_TEXTURE_2D, 0);
 
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
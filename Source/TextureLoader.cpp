@@ -0,0 +1,303 @@
+#include "../Header/TextureLoader.h"
+
+#include "../Header/GlState.h"
+#include "../Header/Trace.h"
+#include "../Header/stb_image.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // Largest band copied through the PBO in one step. Small enough that a step of a
+    // large faceplate fits in a frame's budget, large enough to keep call overhead low.
+    const size_t kBandBytes = 1u << 20;
+
+    GLenum formatFor(int channels)
+    {
+        switch (channels)
+        {
+        case 1: return GL_RED;
+        case 2: return GL_RG;
+        case 3: return GL_RGB;
+        default: return GL_RGBA;
+        }
+    }
+}
+
+constexpr TextureLoader::Handle TextureLoader::kInvalidHandle;
+
+void TextureLoader::ImageDeleter::operator()(unsigned char* pixels) const
+{
+    stbi_image_free(pixels);
+}
+
+TextureLoader::~TextureLoader()
+{
+    // The GL context is gone by now; only the threads still need stopping.
+    stopWorkers();
+}
+
+void TextureLoader::start()
+{
+    // The simulation and render threads already keep two cores busy.
+    unsigned int cores = std::thread::hardware_concurrency();
+    unsigned int workerCount = std::min(std::max(cores / 2, 1u), 4u);
+
+    // Gray checkerboard, drawn with nearest filtering so it reads as "not loaded yet".
+    const unsigned char checker[16] = {
+        96, 96, 96, 255, 160, 160, 160, 255,
+        160, 160, 160, 255, 96, 96, 96, 255
+    };
+    glGenTextures(1, &m_placeholder);
+    glState().bindTexture2D(m_placeholder);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, checker);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glGenBuffers(1, &m_pbo);
+
+    m_stopping = false;
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&TextureLoader::workerLoop, this);
+    }
+}
+
+TextureLoader::Handle TextureLoader::load(const std::string& path)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].path == path) return static_cast<Handle>(i);
+    }
+
+    if (m_workers.empty()) start();
+
+    Entry entry;
+    entry.path = path;
+    m_entries.push_back(entry);
+    Handle handle = static_cast<Handle>(m_entries.size() - 1);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(Job{ handle, path });
+    }
+    m_wake.notify_one();
+    return handle;
+}
+
+GLuint TextureLoader::texture(Handle handle) const
+{
+    if (handle < 0 || handle >= static_cast<Handle>(m_entries.size())) return 0;
+    const Entry& entry = m_entries[handle];
+    return entry.status == Status::Ready ? entry.texture : m_placeholder;
+}
+
+bool TextureLoader::isReady(Handle handle) const
+{
+    return handle >= 0 && handle < static_cast<Handle>(m_entries.size()) && m_entries[handle].status == Status::Ready;
+}
+
+bool TextureLoader::failed(Handle handle) const
+{
+    return handle >= 0 && handle < static_cast<Handle>(m_entries.size()) && m_entries[handle].status == Status::Failed;
+}
+
+int TextureLoader::width(Handle handle) const
+{
+    return handle >= 0 && handle < static_cast<Handle>(m_entries.size()) ? m_entries[handle].width : 0;
+}
+
+int TextureLoader::height(Handle handle) const
+{
+    return handle >= 0 && handle < static_cast<Handle>(m_entries.size()) ? m_entries[handle].height : 0;
+}
+
+bool TextureLoader::update(double budgetSeconds)
+{
+    if (m_workers.empty()) return false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Decoded& decoded : m_decoded)
+        {
+            m_uploads.push_back(std::move(decoded));
+        }
+        m_decoded.clear();
+    }
+    if (m_uploads.empty()) return false;
+
+    AC_TRACE_SCOPE("TextureLoader::update");
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    bool changed = false;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    while (!m_uploads.empty())
+    {
+        Decoded& upload = m_uploads.front();
+        Entry& entry = m_entries[upload.handle];
+        if (!upload.pixels)
+        {
+            std::cout << "Textura nije ucitana! Putanja texture: " << entry.path << std::endl;
+            entry.status = Status::Failed;
+            m_uploads.pop_front();
+            continue;
+        }
+
+        entry.status = Status::Uploading;
+        entry.width = upload.width;
+        entry.height = upload.height;
+        if (uploadBand(upload))
+        {
+            entry.texture = upload.texture;
+            entry.status = Status::Ready;
+            m_uploads.pop_front();
+            changed = true;
+        }
+
+        if (std::chrono::duration<double>(Clock::now() - start).count() >= budgetSeconds) break;
+    }
+    // Left bound, the PBO would turn every later client-memory upload (glyphs) into an offset.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return changed;
+}
+
+bool TextureLoader::uploadBand(Decoded& upload)
+{
+    const GLenum format = formatFor(upload.channels);
+    const size_t rowBytes = static_cast<size_t>(upload.width) * upload.channels;
+
+    if (upload.texture == 0)
+    {
+        // Allocate the storage once; the bands only fill it.
+        glGenTextures(1, &upload.texture);
+        glState().bindTexture2D(upload.texture);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, upload.width, upload.height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    int rows = static_cast<int>(std::max<size_t>(1, kBandBytes / std::max<size_t>(rowBytes, 1)));
+    rows = std::min(rows, upload.height - upload.nextRow);
+    const size_t bytes = rowBytes * rows;
+    const unsigned char* source = upload.pixels.get() + rowBytes * upload.nextRow;
+
+    // Orphan the buffer before mapping, so the driver hands out fresh storage
+    // instead of waiting for the GPU to finish reading the previous band.
+    glState().bindTexture2D(upload.texture);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped)
+    {
+        std::memcpy(mapped, source, bytes);
+    }
+    if (mapped && glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload.nextRow, upload.width, rows, format, GL_UNSIGNED_BYTE, nullptr);
+    }
+    else
+    {
+        // Mapping failed or the buffer was lost: upload this band straight from memory.
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload.nextRow, upload.width, rows, format, GL_UNSIGNED_BYTE, source);
+    }
+
+    upload.nextRow += rows;
+    if (upload.nextRow < upload.height) return false;
+
+    upload.pixels.reset();
+    return true;
+}
+
+void TextureLoader::workerLoop()
+{
+    traceSetThreadName("texture decode");
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        Decoded decoded;
+        decoded.handle = job.handle;
+        {
+            AC_TRACE_SCOPE("texture decode");
+            decoded.pixels.reset(stbi_load(job.path.c_str(), &decoded.width, &decoded.height, &decoded.channels, 0));
+        }
+        if (decoded.pixels && (decoded.width <= 0 || decoded.height <= 0 || decoded.channels < 1 || decoded.channels > 4))
+        {
+            decoded.pixels.reset();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.push_back(std::move(decoded));
+    }
+}
+
+void TextureLoader::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers)
+    {
+        if (worker.joinable()) worker.join();
+    }
+    m_workers.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.clear();
+    m_decoded.clear();
+}
+
+void TextureLoader::clear()
+{
+    stopWorkers();
+
+    for (Decoded& upload : m_uploads)
+    {
+        if (upload.texture == 0) continue;
+        glState().forgetTexture(upload.texture);
+        glDeleteTextures(1, &upload.texture);
+    }
+    m_uploads.clear();
+
+    for (Entry& entry : m_entries)
+    {
+        if (entry.texture == 0) continue;
+        glState().forgetTexture(entry.texture);
+        glDeleteTextures(1, &entry.texture);
+    }
+    m_entries.clear();
+
+    if (m_placeholder != 0)
+    {
+        glState().forgetTexture(m_placeholder);
+        glDeleteTextures(1, &m_placeholder);
+        m_placeholder = 0;
+    }
+    if (m_pbo != 0)
+    {
+        glDeleteBuffers(1, &m_pbo);
+        m_pbo = 0;
+    }
+}
+
+TextureLoader& textureLoader()
+{
+    static TextureLoader loader;
+    return loader;
+}
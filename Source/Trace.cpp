@@ -0,0 +1,185 @@
+#include "../Header/Trace.h"
+
+#ifdef AC_ENABLE_TRACING
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kEventsPerThread = 1 << 16; // power of two
+
+    struct TraceEvent
+    {
+        const char* name;
+        std::uint64_t timestampNs;
+        bool begin;
+    };
+
+    // Ring slot. The fields are atomics because the flushing thread may read a
+    // slot while its owner is overwriting it; relaxed accesses compile to plain
+    // moves on the platforms we ship.
+    struct EventSlot
+    {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::uint64_t> timestampNs{ 0 };
+        std::atomic<bool> begin{ false };
+    };
+
+    // Written only by its own thread. Before overwriting a slot the writer bumps
+    // claimed (then a release fence); after writing it, it publishes head with a
+    // release store. The flusher copies the events below head, then checks claimed
+    // to drop any slot that was reused while it was copying (a seqlock per slot).
+    struct ThreadBuffer
+    {
+        std::unique_ptr<EventSlot[]> events{ new EventSlot[kEventsPerThread] };
+        std::atomic<std::uint64_t> claimed{ 0 };
+        std::atomic<std::uint64_t> head{ 0 };
+        std::uint32_t threadId = 0;
+        std::atomic<const char*> threadName{ nullptr };
+    };
+
+    struct Registry
+    {
+        std::mutex mutex; // taken only when a thread registers and when flushing
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry& registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    ThreadBuffer& localBuffer()
+    {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr)
+        {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.buffers.emplace_back(new ThreadBuffer());
+            buffer = reg.buffers.back().get();
+            buffer->threadId = static_cast<std::uint32_t>(reg.buffers.size());
+        }
+        return *buffer;
+    }
+
+    // Raw clock value; the start of the process is subtracted only when writing the file.
+    const std::uint64_t kOriginNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    std::uint64_t nowNs()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void push(const char* name, bool begin)
+    {
+        ThreadBuffer& buffer = localBuffer();
+        std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        buffer.claimed.store(head + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        EventSlot& slot = buffer.events[head & (kEventsPerThread - 1)];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.timestampNs.store(nowNs(), std::memory_order_relaxed);
+        slot.begin.store(begin, std::memory_order_relaxed);
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    void writeEscaped(std::ofstream& out, const char* text)
+    {
+        for (const char* c = text; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+    }
+}
+
+void traceBegin(const char* name)
+{
+    push(name, true);
+}
+
+void traceEnd()
+{
+    push(nullptr, false);
+}
+
+void traceSetThreadName(const char* name)
+{
+    localBuffer().threadName.store(name, std::memory_order_release);
+}
+
+bool traceWriteChromeJson(const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<TraceEvent> snapshot;
+    snapshot.reserve(kEventsPerThread);
+    for (const auto& buffer : reg.buffers)
+    {
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+        if (threadName)
+        {
+            out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"";
+            writeEscaped(out, threadName);
+            out << "\"}}";
+            first = false;
+        }
+
+        // Copy first, then see how far the owner got meanwhile: event i's slot is
+        // reused by event i + kEventsPerThread, so anything below claimed - size is suspect.
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t start = head > kEventsPerThread ? head - kEventsPerThread : 0;
+        snapshot.clear();
+        for (std::uint64_t i = start; i < head; ++i)
+        {
+            const EventSlot& slot = buffer->events[i & (kEventsPerThread - 1)];
+            snapshot.push_back(TraceEvent{ slot.name.load(std::memory_order_relaxed), slot.timestampNs.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed) });
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t claimed = buffer->claimed.load(std::memory_order_relaxed);
+        std::uint64_t firstIntact = claimed > kEventsPerThread ? claimed - kEventsPerThread : 0;
+        std::size_t skip = static_cast<std::size_t>(std::min<std::uint64_t>(firstIntact > start ? firstIntact - start : 0, snapshot.size()));
+
+        // "E" events close the innermost open "B", so they need no name; drop ends whose begin was overwritten.
+        int depth = 0;
+        for (std::size_t i = skip; i < snapshot.size(); ++i)
+        {
+            const TraceEvent& e = snapshot[i];
+            if (!e.begin && depth == 0) continue;
+            depth += e.begin ? 1 : -1;
+
+            std::uint64_t ns = e.timestampNs > kOriginNs ? e.timestampNs - kOriginNs : 0;
+            out << (first ? "" : ",\n") << "{\"ph\":\"" << (e.begin ? 'B' : 'E') << "\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << (ns / 1000) << '.' << (ns % 1000 / 100);
+            if (e.begin)
+            {
+                out << ",\"name\":\"";
+                writeEscaped(out, e.name);
+                out << '"';
+            }
+            out << '}';
+            first = false;
+        }
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+#endif
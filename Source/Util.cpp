@@ -1,5 +1,9 @@
 #include "../Header/Util.h"
 
+#include "../Header/GlState.h"
+#include "../Header/ShaderCache.h"
+#include "../Header/ShaderSources.h"
+
 #define _CRT_SECURE_NO_WARNINGS
 #include <fstream>
 #include <sstream>
@@ -19,11 +23,9 @@ int endProgram(std::string message) {
     return -1;
 }
 
-unsigned int compileShader(GLenum type, const char* source)
+std::string readShaderSource(const char* source)
 {
-    //Uzima kod u fajlu na putanji "source", kompajlira ga i vraca sejder tipa "type"
-    //Citanje izvornog koda iz fajla
-    std::string content = "";
+    //Cita izvorni kod sejdera iz fajla na putanji "source"
     std::ifstream file(source);
     std::stringstream ss;
     if (file.is_open())
@@ -36,8 +38,13 @@ unsigned int compileShader(GLenum type, const char* source)
         ss << "";
         std::cout << "Greska pri citanju fajla sa putanje \"" << source << "\"!" << std::endl;
     }
-    std::string temp = ss.str();
-    const char* sourceCode = temp.c_str(); //Izvorni kod sejdera koji citamo iz fajla na putanji "source"
+    return ss.str();
+}
+
+unsigned int compileShader(GLenum type, const std::string& code)
+{
+    //Kompajlira izvorni kod "code" i vraca sejder tipa "type"
+    const char* sourceCode = code.c_str(); //Izvorni kod sejdera
 
     int shader = glCreateShader(type); //Napravimo prazan sejder odredjenog tipa (vertex ili fragment)
 
@@ -67,15 +74,23 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     unsigned int vertexShader; //Verteks sejder (za prostorne podatke)
     unsigned int fragmentShader; //Fragment sejder (za boje, teksture itd)
 
+    std::string vertexCode = loadShaderSource(vsSource); //Ugradjeni izvorni kod, osim ako postoji fajl u direktorijumu za izmene
+    std::string fragmentCode = loadShaderSource(fsSource);
+
+    //Ako je isti program vec linkovan na ovom drajveru, ucitaj gotov binarni zapis umesto kompajliranja
+    program = loadCachedProgram(vertexCode, fragmentCode);
+    if (program != 0) return program;
+
     program = glCreateProgram(); //Napravi prazan objedinjeni sejder program
 
-    vertexShader = compileShader(GL_VERTEX_SHADER, vsSource); //Napravi i kompajliraj vertex sejder
-    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsSource); //Napravi i kompajliraj fragment sejder
+    vertexShader = compileShader(GL_VERTEX_SHADER, vertexCode); //Napravi i kompajliraj vertex sejder
+    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentCode); //Napravi i kompajliraj fragment sejder
 
     //Zakaci verteks i fragment sejdere za objedinjeni program
     glAttachShader(program, vertexShader);
     glAttachShader(program, fragmentShader);
 
+    prepareProgramForCache(program);
     glLinkProgram(program); //Povezi ih u jedan objedinjeni sejder program
     glValidateProgram(program); //Izvrsi provjeru novopecenog programa
 
@@ -95,6 +110,7 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     glDetachShader(program, fragmentShader);
     glDeleteShader(fragmentShader);
 
+    storeCachedProgram(program, vertexCode, fragmentCode);
     return program;
 }
 
@@ -120,9 +136,10 @@ unsigned loadImageToTexture(const char* filePath) {
 
         unsigned int Texture;
         glGenTextures(1, &Texture);
-        glBindTexture(GL_TEXTURE_2D, Texture);
+        // Vezivanje ide preko glState() da bi njegova kopija stanja ostala tacna
+        glState().bindTexture2D(Texture);
         glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, TextureWidth, TextureHeight, 0, InternalFormat, GL_UNSIGNED_BYTE, ImageData);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().bindTexture2D(0);
         // oslobadjanje memorije zauzete sa stbi_load posto vise nije potrebna
         stbi_image_free(ImageData);
         return Texture;
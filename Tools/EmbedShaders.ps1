@@ -0,0 +1,44 @@
+# Generates Header/EmbeddedShaders.h from the .vert and .frag files in Shaders/,
+# so the executable carries its own shader sources. Run by the EmbedShaders
+# target in ac-simulator.vcxproj before compiling; the output is not checked in.
+# The header is rewritten only when its content changes, to avoid needless rebuilds.
+param(
+    [Parameter(Mandatory = $true)][string]$ShaderDir,
+    [Parameter(Mandatory = $true)][string]$Output
+)
+
+$ErrorActionPreference = 'Stop'
+
+$lines = New-Object System.Collections.Generic.List[string]
+$lines.Add('// Generated by Tools/EmbedShaders.ps1 from Shaders/. Do not edit.')
+$lines.Add('#pragma once')
+$lines.Add('')
+$lines.Add('struct EmbeddedShader')
+$lines.Add('{')
+$lines.Add('    const char* name; // file name inside Shaders/')
+$lines.Add('    const char* source;')
+$lines.Add('};')
+$lines.Add('')
+$lines.Add('// Terminated by a null entry.')
+$lines.Add('constexpr EmbeddedShader kEmbeddedShaders[] = {')
+
+$files = Get-ChildItem -Path $ShaderDir -File | Where-Object { $_.Extension -in '.vert', '.frag' } | Sort-Object Name
+foreach ($file in $files)
+{
+    $source = [System.IO.File]::ReadAllText($file.FullName) -replace "`r`n", "`n"
+    if ($source.Contains(')GLSL"'))
+    {
+        throw "$($file.Name) contains the raw string delimiter )GLSL`""
+    }
+    $lines.Add("    { `"$($file.Name)`", R`"GLSL($source)GLSL`" },")
+}
+
+$lines.Add('    { nullptr, nullptr }')
+$lines.Add('};')
+
+$text = ($lines -join "`r`n") + "`r`n"
+if ((Test-Path $Output) -and ([System.IO.File]::ReadAllText($Output) -eq $text))
+{
+    exit 0
+}
+[System.IO.File]::WriteAllText($Output, $text)